@@ -0,0 +1,1325 @@
+/*
+ * contents: Unicode Collation Algorithm.
+ *
+ * Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+ */
+
+#ifdef HAVE_PTHREAD_H
+/* We’re compiled with -std=c99, which hides pthread_sigmask() and friends. */
+#  define _XOPEN_SOURCE 600
+#endif
+
+#include <ruby.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_PTHREAD_H
+#  include <pthread.h>
+#  include <setjmp.h>
+#  include <signal.h>
+#  include <unistd.h>
+#endif
+
+#include "unicode.h"
+
+#include "data/collate.h"
+
+#include "private.h"
+
+#define COLLATE_LEVELS                  4
+
+#define COLLATE_IMPLICIT_BASE_UNASSIGNED 0xfbc0
+
+#define COLLATE_TAILORING_BASE          0xfff0
+#define COLLATE_TAILORING_MAX_LETTERS   3
+
+
+/* {{{1
+ * Append the two implicit collation elements of ‘c’, which has no entry in
+ * the DUCET, to ‘elements’.
+ */
+static void
+collation_elements_add_implicit(UnicharBuffer *elements, unichar c)
+{
+        uint16_t first = COLLATE_IMPLICIT_BASE_UNASSIGNED + (c >> 15);
+        uint16_t second = (c & 0x7fff) | 0x8000;
+
+        for (size_t i = 0; i < lengthof(collate_implicit_weights); i++) {
+                if (c >= collate_implicit_weights[i].first &&
+                    c <= collate_implicit_weights[i].last) {
+                        first = collate_implicit_weights[i].base;
+                        second = ((c - collate_implicit_weights[i].offset) &
+                                  0x7fff) | 0x8000;
+                        break;
+                }
+        }
+
+        if (c >= collate_unified_ideographs[0].first) {
+                for (size_t i = 0; i < lengthof(collate_unified_ideographs); i++) {
+                        if (c < collate_unified_ideographs[i].first)
+                                break;
+                        if (c <= collate_unified_ideographs[i].last) {
+                                first = collate_unified_ideographs[i].base +
+                                        (c >> 15);
+                                break;
+                        }
+                }
+        }
+
+        unichar_buffer_append(elements, COLLATION_ELEMENT(first, 0x0020, 0x0002));
+        unichar_buffer_append(elements, COLLATION_ELEMENT(second, 0, 0));
+}
+
+
+/* {{{1
+ * Locales whose alphabets have letters that sort after ‘anchor’ as letters of
+ * their own, in the order given, instead of as ‘anchor’ with a diacritic, or
+ * at the place of the letter that they’re derived from.  The uppercase forms
+ * of the letters are tailored as well.  Locales that aren’t listed, and
+ * tailorings other than these, use the order of the DUCET.
+ */
+static const struct {
+        const char *language;
+        unichar anchor;
+        unichar letters[COLLATE_TAILORING_MAX_LETTERS];
+} collate_locales[] = {
+        { "da", 'z', { 0x00e6, 0x00f8, 0x00e5 } },
+        { "es", 'n', { 0x00f1 } },
+        { "fi", 'z', { 0x00e5, 0x00e4, 0x00f6 } },
+        { "nb", 'z', { 0x00e6, 0x00f8, 0x00e5 } },
+        { "nn", 'z', { 0x00e6, 0x00f8, 0x00e5 } },
+        { "no", 'z', { 0x00e6, 0x00f8, 0x00e5 } },
+        { "sv", 'z', { 0x00e5, 0x00e4, 0x00f6 } },
+};
+
+
+/* {{{1
+ * A tailored letter, as a character in NFD followed by at most one
+ * non-starter, and its collation elements.  The first has the primary weight
+ * of the anchor of the tailoring, and the second has a primary weight above
+ * that of anything in the DUCET that decides where the letter goes among the
+ * letters that follow the anchor.
+ */
+typedef struct _CollateTailoring CollateTailoring;
+
+struct _CollateTailoring {
+        unichar chars[2];
+        size_t n_chars;
+        uint32_t elements[2];
+};
+
+struct _UTFCollator {
+        CollateStrength strength;
+        bool numeric;
+        CollateCaseFirst case_first;
+        CollateTailoring *tailorings;
+        size_t n_tailorings;
+};
+
+static const UTFCollator collate_default = {
+        COLLATE_STRENGTH_QUATERNARY, false, COLLATE_CASE_FIRST_OFF, NULL, 0
+};
+
+
+/* {{{1
+ * Look up the collation element of ‘c’, which must have exactly one in the
+ * DUCET.
+ */
+static uint32_t
+collation_element_of(unichar c)
+{
+        int index;
+
+        if (!unicode_table_lookup(collate, c, &index))
+                return 0;
+
+        return collation_elements[collate_table[index].offset];
+}
+
+static void
+collate_tailoring_init(CollateTailoring *tailoring, unichar c, uint16_t primary,
+                       uint16_t tertiary, int position)
+{
+        size_t len;
+        unichar *decomposition = unicode_canonical_decomposition(c, &len);
+
+        tailoring->n_chars = (len < 2) ? len : 2;
+        memcpy(tailoring->chars, decomposition,
+               tailoring->n_chars * sizeof(unichar));
+        free(decomposition);
+
+        tailoring->elements[0] = COLLATION_ELEMENT(primary, 0x0020, tertiary);
+        tailoring->elements[1] =
+                COLLATION_ELEMENT(COLLATE_TAILORING_BASE + position, 0, 0);
+}
+
+/* {{{1
+ * Create a collator that compares strings at the levels up to and including
+ * ‘strength’.  The tailorings of ‘locale’, which is a language code that may
+ * be followed by ‘_’ or ‘-’ and a region, are compiled into a table of their
+ * own.  If ‘numeric’ is true, sequences of decimal digits are compared by
+ * their numeric value.  ‘case_first’ may put uppercase letters before
+ * lowercase ones, which is otherwise the order of the DUCET.
+ *
+ * A collator isn’t modified once it’s been created, so it may be shared
+ * between threads.
+ */
+UTFCollator *
+utf_collator_new(const char *locale, CollateStrength strength, bool numeric,
+                 CollateCaseFirst case_first)
+{
+        UTFCollator *collator = ALLOC(UTFCollator);
+
+        collator->strength = strength;
+        collator->numeric = numeric;
+        collator->case_first = case_first;
+        collator->tailorings = NULL;
+        collator->n_tailorings = 0;
+
+        size_t len = (locale == NULL) ? 0 : strcspn(locale, "_-");
+        for (size_t i = 0; i < lengthof(collate_locales); i++) {
+                if (strlen(collate_locales[i].language) != len ||
+                    strncmp(collate_locales[i].language, locale, len) != 0)
+                        continue;
+
+                uint16_t primary = COLLATION_ELEMENT_PRIMARY(
+                        collation_element_of(collate_locales[i].anchor));
+                collator->tailorings =
+                        ALLOC_N(CollateTailoring,
+                                2 * COLLATE_TAILORING_MAX_LETTERS);
+                for (int j = 0; j < COLLATE_TAILORING_MAX_LETTERS; j++) {
+                        unichar c = collate_locales[i].letters[j];
+                        if (c == 0)
+                                break;
+
+                        CollateTailoring *tailoring =
+                                collator->tailorings + collator->n_tailorings;
+                        collate_tailoring_init(&tailoring[0], c, primary,
+                                               0x0002, j);
+                        collate_tailoring_init(&tailoring[1],
+                                               unichar_toupper(c), primary,
+                                               0x0008, j);
+                        collator->n_tailorings += 2;
+                }
+                break;
+        }
+
+        return collator;
+}
+
+void
+utf_collator_free(UTFCollator *collator)
+{
+        free(collator->tailorings);
+        free(collator);
+}
+
+
+/* {{{1
+ * The characters of a string in NFD, normalized as they are needed.  The
+ * normalizer hands over a segment, that is, a starter and the non-starters
+ * that follow it, once the next starter arrives, so every segment in ‘chars’
+ * but the last is complete.  ‘n_starters’ counts the starters in ‘chars’, so
+ * that we know when enough of the string has been normalized to match the
+ * longest contraction.
+ */
+typedef struct _CollateInput CollateInput;
+
+struct _CollateInput {
+        const UTFCollator *collator;
+        const char *p;
+        const char *end;
+        bool use_end;
+        bool finished;
+        NormalizeStream stream;
+        UnicharBuffer chars;
+        size_t n_starters;
+};
+
+static void
+collate_input_add(unichar c, void *closure)
+{
+        CollateInput *input = closure;
+
+        unichar_buffer_append(&input->chars, c);
+        if (unichar_combining_class(c) == 0)
+                input->n_starters++;
+}
+
+static void
+collate_input_init(CollateInput *input, const UTFCollator *collator,
+                   const char *str, size_t len, bool use_len)
+{
+        input->collator = collator;
+        input->p = str;
+        input->end = str + len;
+        input->use_end = use_len;
+        input->finished = false;
+        normalize_stream_init(&input->stream, NORMALIZE_NFD,
+                              collate_input_add, input);
+        unichar_buffer_init(&input->chars);
+        input->n_starters = 0;
+}
+
+static void
+collate_input_free(CollateInput *input)
+{
+        if (!input->finished)
+                normalize_stream_finish(&input->stream);
+        unichar_buffer_free(&input->chars);
+}
+
+/* {{{1
+ * Feed the next character of the string to the normalizer, returning false
+ * if there are none left.
+ */
+static bool
+collate_input_feed(CollateInput *input)
+{
+        if (input->finished)
+                return false;
+
+        if ((input->use_end && input->p >= input->end) || *input->p == NUL) {
+                normalize_stream_finish(&input->stream);
+                input->finished = true;
+                return true;
+        }
+
+        const char *next = utf_next(input->p);
+        normalize_stream_feed(&input->stream, input->p, next - input->p, true);
+        input->p = next;
+
+        return true;
+}
+
+/* {{{1
+ * Remove the first ‘n’ characters of ‘input’.
+ */
+static void
+collate_input_skip(CollateInput *input, size_t n)
+{
+        UnicharBuffer *chars = &input->chars;
+
+        for (size_t i = 0; i < n; i++)
+                if (unichar_combining_class(chars->chars[i]) == 0)
+                        input->n_starters--;
+
+        chars->len -= n;
+        memmove(chars->chars, chars->chars + n, chars->len * sizeof(unichar));
+}
+
+
+/* {{{1
+ * Look for a contraction among the ‘n’ contractions beginning at
+ * ‘contractions’ that consists of the ‘n_matched’ characters in ‘matched’
+ * followed by ‘c’.
+ */
+static int
+find_contraction(int contractions, int n, const unichar *matched,
+                 size_t n_matched, unichar c)
+{
+        for (int i = contractions; i < contractions + n; i++) {
+                if (collate_contractions[i].n_chars == n_matched + 1 &&
+                    collate_contractions[i].chars[n_matched] == c &&
+                    memcmp(collate_contractions[i].chars, matched,
+                           n_matched * sizeof(unichar)) == 0)
+                        return i;
+        }
+
+        return -1;
+}
+
+/* {{{1
+ * If the next character of ‘input’ begins a letter tailored by its collator,
+ * remove the letter from the input and append its collation elements to
+ * ‘elements’.  As with contractions, the non-starter of a tailored letter
+ * may be separated from its starter by other, unblocked, non-starters.
+ */
+static bool
+collate_input_next_tailored(CollateInput *input, UnicharBuffer *elements)
+{
+        const UTFCollator *collator = input->collator;
+        unichar c = input->chars.chars[0];
+
+        for (size_t t = 0; t < collator->n_tailorings; t++) {
+                const CollateTailoring *tailoring = &collator->tailorings[t];
+                if (tailoring->chars[0] != c)
+                        continue;
+
+                if (tailoring->n_chars > 1) {
+                        while (input->n_starters < 2 &&
+                               collate_input_feed(input))
+                                ;
+
+                        unichar *chars = input->chars.chars;
+                        size_t n = input->chars.len;
+                        int last_cc = 0;
+                        size_t i;
+                        for (i = 1; i < n; i++) {
+                                int cc = unichar_combining_class(chars[i]);
+                                if (cc == 0 ||
+                                    (chars[i] == tailoring->chars[1] &&
+                                     last_cc < cc))
+                                        break;
+                                last_cc = cc;
+                        }
+                        if (i == n || chars[i] != tailoring->chars[1])
+                                continue;
+
+                        memmove(chars + i, chars + i + 1,
+                                (n - i - 1) * sizeof(unichar));
+                        input->chars.len--;
+                }
+
+                collate_input_skip(input, 1);
+                unichar_buffer_append(elements, tailoring->elements[0]);
+                unichar_buffer_append(elements, tailoring->elements[1]);
+
+                return true;
+        }
+
+        return false;
+}
+
+/* {{{1
+ * If ‘input’ continues with decimal digits, remove them from it and append
+ * collation elements to ‘elements’ that compare them by their numeric value.
+ * The first collation element has the primary weight of ‘0’, so that numbers
+ * sort among digits.  It is followed by one whose primary weight is the
+ * number of significant digits, and then one per significant digit with the
+ * primary weight of the corresponding ASCII digit.  Leading zeros are thus
+ * ignored.
+ */
+static bool
+collate_input_next_numeric(CollateInput *input, UnicharBuffer *elements)
+{
+        if (unichar_digit_value(input->chars.chars[0]) < 0)
+                return false;
+
+        size_t n = 0;
+        while (true) {
+                while (n == input->chars.len && collate_input_feed(input))
+                        ;
+                if (n == input->chars.len ||
+                    unichar_digit_value(input->chars.chars[n]) < 0)
+                        break;
+                n++;
+        }
+
+        const unichar *digits = input->chars.chars;
+        size_t first = 0;
+        while (first < n - 1 && unichar_digit_value(digits[first]) == 0)
+                first++;
+        size_t n_significant = n - first;
+
+        uint32_t zero = collation_element_of('0');
+        uint32_t element = collation_element_of(digits[0]);
+        if (element == 0)
+                element = zero;
+        unichar_buffer_append(elements,
+                              COLLATION_ELEMENT(COLLATION_ELEMENT_PRIMARY(zero),
+                                                COLLATION_ELEMENT_SECONDARY(element),
+                                                COLLATION_ELEMENT_TERTIARY(element)));
+        unichar_buffer_append(elements,
+                              COLLATION_ELEMENT((n_significant < 0xffff) ?
+                                                n_significant : 0xffff, 0, 0));
+        for (size_t i = first; i < n; i++) {
+                int value = unichar_digit_value(digits[i]);
+                uint16_t primary =
+                        COLLATION_ELEMENT_PRIMARY(collation_element_of('0' + value));
+                unichar_buffer_append(elements,
+                                      COLLATION_ELEMENT(primary, 0, 0));
+        }
+
+        collate_input_skip(input, n);
+
+        return true;
+}
+
+/* {{{1
+ * Append the collation elements of the next character or contraction of
+ * ‘input’ to ‘elements’, returning false once the input is exhausted.
+ *
+ * The longest contraction that matches the following characters is used.
+ * Then, as long as it can be extended by an unblocked non-starter that
+ * follows it, that is, one that isn’t preceded by a skipped character of the
+ * same combining class, it is, and that non-starter is removed from the
+ * input.
+ */
+static bool
+collate_input_next_elements(CollateInput *input, UnicharBuffer *elements)
+{
+        while (input->chars.len == 0)
+                if (!collate_input_feed(input))
+                        return false;
+
+        if (collate_input_next_tailored(input, elements) ||
+            (input->collator->numeric &&
+             collate_input_next_numeric(input, elements)))
+                return true;
+
+        unichar c = input->chars.chars[0];
+        int index;
+        if (!unicode_table_lookup(collate, c, &index)) {
+                collate_input_skip(input, 1);
+                collation_elements_add_implicit(elements, c);
+                return true;
+        }
+
+        int offset = collate_table[index].offset;
+        size_t length = collate_table[index].length;
+        int n_contractions = collate_table[index].n_contractions;
+        size_t n_contiguous = 1;
+
+        if (n_contractions > 0) {
+                while (input->n_starters < COLLATE_MAX_CONTRACTION_LENGTH &&
+                       collate_input_feed(input))
+                        ;
+
+                int contractions = collate_table[index].contractions;
+                unichar *chars = input->chars.chars;
+                size_t n = input->chars.len;
+
+                for (int i = contractions; i < contractions + n_contractions; i++) {
+                        size_t n_chars = collate_contractions[i].n_chars;
+                        if (n_chars <= n &&
+                            memcmp(collate_contractions[i].chars, chars,
+                                   n_chars * sizeof(unichar)) == 0) {
+                                offset = collate_contractions[i].offset;
+                                length = collate_contractions[i].length;
+                                n_contiguous = n_chars;
+                                break;
+                        }
+                }
+
+                unichar matched[COLLATE_MAX_CONTRACTION_LENGTH];
+                size_t n_matched = n_contiguous;
+                memcpy(matched, chars, n_matched * sizeof(unichar));
+                int last_cc = 0;
+                size_t i = n_matched;
+                while (i < n && n_matched < COLLATE_MAX_CONTRACTION_LENGTH) {
+                        int cc = unichar_combining_class(chars[i]);
+                        if (cc == 0)
+                                break;
+
+                        int j;
+                        if (last_cc < cc &&
+                            (j = find_contraction(contractions, n_contractions,
+                                                  matched, n_matched,
+                                                  chars[i])) != -1) {
+                                offset = collate_contractions[j].offset;
+                                length = collate_contractions[j].length;
+                                matched[n_matched++] = chars[i];
+                                memmove(chars + i, chars + i + 1,
+                                        (n - i - 1) * sizeof(unichar));
+                                input->chars.len = --n;
+                                continue;
+                        }
+
+                        last_cc = cc;
+                        i++;
+                }
+        }
+
+        collate_input_skip(input, n_contiguous);
+
+        if (length == 0) {
+                collation_elements_add_implicit(elements, c);
+                return true;
+        }
+
+        for (size_t i = 0; i < length; i++)
+                unichar_buffer_append(elements, collation_elements[offset + i]);
+
+        return true;
+}
+
+/* {{{1
+ * Swap the tertiary weights of lowercase and uppercase forms in ‘element’,
+ * following the tertiary weights given in UTS #10, so that uppercase
+ * letters sort before lowercase ones.
+ */
+static uint32_t
+collation_element_upper_first(uint32_t element)
+{
+        uint16_t tertiary = COLLATION_ELEMENT_TERTIARY(element);
+
+        if (tertiary >= 0x02 && tertiary <= 0x06)
+                tertiary += 6;
+        else if (tertiary >= 0x08 && tertiary <= 0x0c)
+                tertiary -= 6;
+        else if (tertiary == 0x1c)
+                tertiary = 0x1d;
+        else if (tertiary == 0x1d)
+                tertiary = 0x1c;
+        else
+                return element;
+
+        return (element & ~COLLATION_ELEMENT(0, 0, 0x1f)) |
+                COLLATION_ELEMENT(0, 0, tertiary);
+}
+
+/* {{{1
+ * Append the collation elements of the next character, contraction,
+ * tailored letter, or number of ‘input’ to ‘elements’, as its collator
+ * wants them, returning false once the input is exhausted.
+ */
+static bool
+collate_input_next(CollateInput *input, UnicharBuffer *elements)
+{
+        size_t first = elements->len;
+
+        if (!collate_input_next_elements(input, elements))
+                return false;
+
+        if (input->collator->case_first == COLLATE_CASE_FIRST_UPPER)
+                for (size_t i = first; i < elements->len; i++)
+                        elements->chars[i] =
+                                collation_element_upper_first(elements->chars[i]);
+
+        return true;
+}
+
+
+/* {{{1
+ * Append the collation elements of a string to ‘elements’, reading it with
+ * ‘input’.
+ */
+static void
+collation_elements_collect(UnicharBuffer *elements, CollateInput *input,
+                           const UTFCollator *collator, const char *str,
+                           size_t len, bool use_len)
+{
+        collate_input_init(input, collator, str, len, use_len);
+        while (collate_input_next(input, elements))
+                ;
+        collate_input_free(input);
+}
+
+
+/* {{{1
+ * Iterate over the non-zero weights at one level of a sequence of collation
+ * elements.  Variable collation elements are shifted to the fourth level, and
+ * ignorables that follow them are ignored at all levels.  Other collation
+ * elements are given the highest weight at that level.
+ */
+typedef struct _CollateLevelIterator CollateLevelIterator;
+
+struct _CollateLevelIterator {
+        const uint32_t *elements;
+        size_t n;
+        size_t i;
+        int level;
+        bool after_variable;
+};
+
+static void
+collate_level_iterator_init(CollateLevelIterator *iter,
+                            const UnicharBuffer *elements, int level)
+{
+        iter->elements = elements->chars;
+        iter->n = elements->len;
+        iter->i = 0;
+        iter->level = level;
+        iter->after_variable = false;
+}
+
+static uint16_t
+collation_element_weight(uint32_t element, int level)
+{
+        switch (level) {
+        case 1:
+                return COLLATION_ELEMENT_PRIMARY(element);
+        case 2:
+                return COLLATION_ELEMENT_SECONDARY(element);
+        case 3:
+                return COLLATION_ELEMENT_TERTIARY(element);
+        default:
+                /* Continuation elements, like the second element of an
+                 * implicit weight, are ignorable at this level. */
+                return (COLLATION_ELEMENT_TERTIARY(element) != 0) ? 0xffff : 0;
+        }
+}
+
+static bool
+collate_level_iterator_next(CollateLevelIterator *iter, uint16_t *weight)
+{
+        while (iter->i < iter->n) {
+                uint32_t element = iter->elements[iter->i++];
+                uint16_t w;
+
+                if (COLLATION_ELEMENT_IS_VARIABLE(element)) {
+                        iter->after_variable = true;
+                        w = (iter->level == 4) ?
+                                COLLATION_ELEMENT_PRIMARY(element) : 0;
+                } else if (element == 0) {
+                        w = 0;
+                } else if (COLLATION_ELEMENT_PRIMARY(element) != 0) {
+                        iter->after_variable = false;
+                        w = collation_element_weight(element, iter->level);
+                } else {
+                        w = iter->after_variable ?
+                                0 : collation_element_weight(element, iter->level);
+                }
+
+                if (w != 0) {
+                        *weight = w;
+                        return true;
+                }
+        }
+
+        return false;
+}
+
+
+/* {{{1
+ * Compare two sequences of collation elements level by level, beginning at
+ * ‘first_level’ and ending at ‘last_level’, in the same way as memcmp()
+ * would compare their sort keys.
+ */
+static int
+collation_elements_compare(const UnicharBuffer *a, const UnicharBuffer *b,
+                           int first_level, int last_level)
+{
+        for (int level = first_level; level <= last_level; level++) {
+                CollateLevelIterator a_iter, b_iter;
+
+                collate_level_iterator_init(&a_iter, a, level);
+                collate_level_iterator_init(&b_iter, b, level);
+                while (true) {
+                        uint16_t a_weight, b_weight;
+                        bool a_more = collate_level_iterator_next(&a_iter, &a_weight);
+                        bool b_more = collate_level_iterator_next(&b_iter, &b_weight);
+
+                        if (!a_more || !b_more) {
+                                if (a_more != b_more)
+                                        return a_more ? 1 : -1;
+                                break;
+                        }
+
+                        if (a_weight != b_weight)
+                                return (a_weight < b_weight) ? -1 : 1;
+                }
+        }
+
+        return 0;
+}
+
+
+/* {{{1
+ * The primary weights of the collation elements of a string, generated as
+ * they are needed.  The collation elements are kept in ‘elements’, so that
+ * the other levels can be compared once the primary weights turn out to be
+ * equal.  Variable collation elements and ignorables have no primary weight
+ * once variable collation elements have been shifted, so they are skipped.
+ */
+typedef struct _CollatePrimaryIterator CollatePrimaryIterator;
+
+struct _CollatePrimaryIterator {
+        CollateInput input;
+        UnicharBuffer elements;
+        size_t i;
+};
+
+static void
+collate_primary_iterator_init(CollatePrimaryIterator *iter,
+                              const UTFCollator *collator, const char *str,
+                              size_t len, bool use_len)
+{
+        collate_input_init(&iter->input, collator, str, len, use_len);
+        unichar_buffer_init(&iter->elements);
+        iter->i = 0;
+}
+
+static void
+collate_primary_iterator_free(CollatePrimaryIterator *iter)
+{
+        collate_input_free(&iter->input);
+        unichar_buffer_free(&iter->elements);
+}
+
+static bool
+collate_primary_iterator_next(CollatePrimaryIterator *iter, uint16_t *weight)
+{
+        while (true) {
+                while (iter->i == iter->elements.len)
+                        if (!collate_input_next(&iter->input, &iter->elements))
+                                return false;
+
+                uint32_t element = iter->elements.chars[iter->i++];
+                if (!COLLATION_ELEMENT_IS_VARIABLE(element) &&
+                    COLLATION_ELEMENT_PRIMARY(element) != 0) {
+                        *weight = COLLATION_ELEMENT_PRIMARY(element);
+                        return true;
+                }
+        }
+}
+
+
+/* {{{1
+ * Compare two strings for ordering using the Unicode Collation Algorithm
+ * with the DUCET, as tailored by ‘collator’, shifting variable collation
+ * elements to the fourth level.  The result doesn’t depend on the current
+ * locale.
+ *
+ * Most strings differ at the primary level, often early on, so the primary
+ * weights are compared as the strings are normalized and turned into
+ * collation elements, stopping at the first difference.  Only if there is
+ * none are the remaining levels compared.
+ */
+static int
+utf_collate_impl(const UTFCollator *collator, const char *a, size_t a_len,
+                 const char *b, size_t b_len, bool use_len)
+{
+        CollatePrimaryIterator a_iter, b_iter;
+        int result = 0;
+
+        collate_primary_iterator_init(&a_iter, collator, a, a_len, use_len);
+        collate_primary_iterator_init(&b_iter, collator, b, b_len, use_len);
+        while (true) {
+                uint16_t a_weight, b_weight;
+                bool a_more = collate_primary_iterator_next(&a_iter, &a_weight);
+                bool b_more = collate_primary_iterator_next(&b_iter, &b_weight);
+
+                if (!a_more || !b_more) {
+                        if (a_more != b_more)
+                                result = a_more ? 1 : -1;
+                        break;
+                }
+
+                if (a_weight != b_weight) {
+                        result = (a_weight < b_weight) ? -1 : 1;
+                        break;
+                }
+        }
+        if (result == 0)
+                result = collation_elements_compare(&a_iter.elements,
+                                                    &b_iter.elements, 2,
+                                                    collator->strength);
+        collate_primary_iterator_free(&a_iter);
+        collate_primary_iterator_free(&b_iter);
+
+        return result;
+}
+
+int
+utf_collate(const char *a, const char *b)
+{
+        return utf_collate_impl(&collate_default, a, 0, b, 0, false);
+}
+
+int
+utf_collate_n(const char *a, size_t a_len, const char *b, size_t b_len)
+{
+        return utf_collate_impl(&collate_default, a, a_len, b, b_len, true);
+}
+
+int
+utf_collator_compare_n(const UTFCollator *collator, const char *a,
+                       size_t a_len, const char *b, size_t b_len)
+{
+        return utf_collate_impl(collator, a, a_len, b, b_len, true);
+}
+
+
+/* {{{1
+ * The buffers that generating a sort key uses besides the key itself.  A
+ * CollateSortJob keeps its own, instead of leaving them in the frames of
+ * collate_key_generate(), so that they can still be freed if
+ * normalize_guard() jumps out of the job halfway through a key.  They’re
+ * freed after each key, so this only matters if that happens.
+ */
+typedef struct _CollateKeyBuffers CollateKeyBuffers;
+
+struct _CollateKeyBuffers {
+        UnicharBuffer elements;
+        CollateInput input;
+};
+
+static void
+collate_key_buffers_init(CollateKeyBuffers *buffers)
+{
+        unichar_buffer_init(&buffers->elements);
+        normalize_stream_init(&buffers->input.stream, NORMALIZE_NFD,
+                              collate_input_add, &buffers->input);
+        unichar_buffer_init(&buffers->input.chars);
+}
+
+static void
+collate_key_buffers_free(CollateKeyBuffers *buffers)
+{
+        unichar_buffer_free(&buffers->elements);
+        normalize_stream_free(&buffers->input.stream);
+        unichar_buffer_free(&buffers->input.chars);
+}
+
+
+/* {{{1
+ * Generate a sort key from a string which can be compared with other sort
+ * keys using memcmp(), the shorter key being less if one is a prefix of the
+ * other.  The key consists of the weights at each level as 16-bit big-endian
+ * integers, with a zero weight separating the levels, so it may contain NUL
+ * bytes.  Only the levels up to the strength of ‘collator’ are included.
+ * Its length is stored in ‘key_len’.  ‘buffers’ must have been set up with
+ * collate_key_buffers_init().
+ */
+static char *
+collate_key_generate(CollateKeyBuffers *buffers, const UTFCollator *collator,
+                     const char *str, size_t len, bool use_len,
+                     size_t *key_len)
+{
+        UnicharBuffer *elements = &buffers->elements;
+        int levels = collator->strength;
+
+        collation_elements_collect(elements, &buffers->input, collator, str,
+                                   len, use_len);
+
+        char *key = NORMALIZE_ALLOC_N(char, 2 * (levels * elements->len +
+                                                 levels - 1) + 1);
+        char *p = key;
+        for (int level = 1; level <= levels; level++) {
+                if (level > 1) {
+                        *p++ = NUL;
+                        *p++ = NUL;
+                }
+
+                CollateLevelIterator iter;
+                uint16_t weight;
+                collate_level_iterator_init(&iter, elements, level);
+                while (collate_level_iterator_next(&iter, &weight)) {
+                        *p++ = weight >> 8;
+                        *p++ = weight & 0xff;
+                }
+        }
+        *p = NUL;
+        *key_len = p - key;
+
+        unichar_buffer_free(elements);
+
+        return key;
+}
+
+static char *
+utf_collate_key_impl(const UTFCollator *collator, const char *str,
+                     size_t len, bool use_len, size_t *key_len)
+{
+        CollateKeyBuffers buffers;
+
+        collate_key_buffers_init(&buffers);
+
+        return collate_key_generate(&buffers, collator, str, len, use_len,
+                                    key_len);
+}
+
+char *
+utf_collate_key(const char *str, size_t *key_len)
+{
+        return utf_collate_key_impl(&collate_default, str, 0, false, key_len);
+}
+
+char *
+utf_collate_key_n(const char *str, size_t len, size_t *key_len)
+{
+        return utf_collate_key_impl(&collate_default, str, len, true, key_len);
+}
+
+char *
+utf_collator_key_n(const UTFCollator *collator, const char *str, size_t len,
+                   size_t *key_len)
+{
+        return utf_collate_key_impl(collator, str, len, true, key_len);
+}
+
+
+/* {{{1
+ * Store the first ‘n’ bytes of the sort key of a string in ‘prefix’, padding
+ * it with NUL bytes if the key is shorter.  As with utf_collate(), the string
+ * is only normalized and turned into collation elements as far as the
+ * primary weights needed require, so a short prefix of a long string is
+ * cheap.  Only if the primary weights of the string don’t fill the prefix
+ * are the other levels needed, and then all collation elements are known.
+ *
+ * Padding with NUL bytes keeps the order of the keys: if one key is less
+ * than another, its prefix is less than or equal to the other’s.  Equal
+ * prefixes must be resolved by comparing the strings or their full keys.
+ * Read as big-endian integers, prefixes of 8 bytes can be compared, and
+ * radix sorted, as 64-bit integers.
+ */
+static void
+utf_collate_key_prefix_impl(const UTFCollator *collator, const char *str,
+                            size_t len, bool use_len, char *prefix, size_t n)
+{
+        CollatePrimaryIterator primaries;
+        char *p = prefix;
+        char *end = prefix + n;
+        uint16_t weight;
+
+        collate_primary_iterator_init(&primaries, collator, str, len, use_len);
+        while (p < end && collate_primary_iterator_next(&primaries, &weight)) {
+                *p++ = weight >> 8;
+                if (p < end)
+                        *p++ = weight & 0xff;
+        }
+
+        int levels = collator->strength;
+        for (int level = 2; level <= levels && p < end; level++) {
+                *p++ = NUL;
+                if (p < end)
+                        *p++ = NUL;
+
+                CollateLevelIterator iter;
+                collate_level_iterator_init(&iter, &primaries.elements, level);
+                while (p < end && collate_level_iterator_next(&iter, &weight)) {
+                        *p++ = weight >> 8;
+                        if (p < end)
+                                *p++ = weight & 0xff;
+                }
+        }
+        collate_primary_iterator_free(&primaries);
+
+        memset(p, NUL, end - p);
+}
+
+void
+utf_collate_key_prefix(const char *str, char *prefix, size_t n)
+{
+        utf_collate_key_prefix_impl(&collate_default, str, 0, false, prefix, n);
+}
+
+void
+utf_collate_key_prefix_n(const char *str, size_t len, char *prefix, size_t n)
+{
+        utf_collate_key_prefix_impl(&collate_default, str, len, true, prefix, n);
+}
+
+
+/* {{{1
+ * Generate the bounds of the sort keys of the strings that begin with
+ * ‘prefix’, so that they can be found in a sorted array of sort keys by
+ * binary search.  Such a key begins with the primary weights of the prefix,
+ * which is the inclusive lower bound stored in ‘lower’.  The exclusive upper
+ * bound stored in ‘upper’ is the shortest string greater than every string
+ * that begins with the lower bound, or NULL if there is none, that is, if
+ * the lower bound is empty or consists of 0xff bytes.
+ *
+ * Strings that differ from the prefix only at the secondary and higher
+ * levels, for example in accents or case, thus fall within the bounds as
+ * well.  A prefix that ends in the middle of a contraction or, with a
+ * numeric collator, of a number, only covers the strings in which that
+ * contraction or number ends where the prefix ends.  The same goes for
+ * combining marks that canonical ordering would move into the prefix.
+ */
+static void
+utf_collate_prefix_bounds_impl(const UTFCollator *collator, const char *prefix,
+                               size_t len, char **lower, size_t *lower_len,
+                               char **upper, size_t *upper_len)
+{
+        UnicharBuffer elements;
+        CollateInput input;
+
+        unichar_buffer_init(&elements);
+        collation_elements_collect(&elements, &input, collator, prefix, len,
+                                   true);
+
+        char *bound = ALLOC_N(char, 2 * elements.len + 1);
+        char *p = bound;
+        CollateLevelIterator iter;
+        uint16_t weight;
+        collate_level_iterator_init(&iter, &elements, 1);
+        while (collate_level_iterator_next(&iter, &weight)) {
+                *p++ = weight >> 8;
+                *p++ = weight & 0xff;
+        }
+        *p = NUL;
+        *lower = bound;
+        *lower_len = p - bound;
+
+        unichar_buffer_free(&elements);
+
+        while (p > bound && (unsigned char)p[-1] == 0xff)
+                p--;
+        if (p == bound) {
+                *upper = NULL;
+                *upper_len = 0;
+                return;
+        }
+
+        *upper_len = p - bound;
+        *upper = ALLOC_N(char, *upper_len + 1);
+        memcpy(*upper, bound, *upper_len);
+        (*upper)[*upper_len - 1]++;
+        (*upper)[*upper_len] = NUL;
+}
+
+void
+utf_collate_prefix_bounds_n(const char *prefix, size_t len, char **lower,
+                            size_t *lower_len, char **upper, size_t *upper_len)
+{
+        utf_collate_prefix_bounds_impl(&collate_default, prefix, len,
+                                       lower, lower_len, upper, upper_len);
+}
+
+void
+utf_collator_prefix_bounds_n(const UTFCollator *collator, const char *prefix,
+                             size_t len, char **lower, size_t *lower_len,
+                             char **upper, size_t *upper_len)
+{
+        utf_collate_prefix_bounds_impl(collator, prefix, len,
+                                       lower, lower_len, upper, upper_len);
+}
+
+
+/* {{{1
+ * Generate the sort keys of the strings in ‘keys’ that don’t have one yet,
+ * using ‘buffers’.
+ */
+static void
+collate_sort_keys_generate(const UTFCollator *collator,
+                           CollateKeyBuffers *buffers, CollateSortKey *keys,
+                           size_t n)
+{
+        for (size_t i = 0; i < n; i++)
+                if (keys[i].key == NULL)
+                        keys[i].key = collate_key_generate(buffers, collator,
+                                                           keys[i].str,
+                                                           keys[i].len, true,
+                                                           &keys[i].key_len);
+}
+
+
+#ifdef HAVE_PTHREAD_H
+/* {{{1
+ * Sorting at least twice COLLATE_SORT_PARALLEL_MIN_KEYS strings, their sort
+ * keys are generated by one job per processor, at most
+ * COLLATE_SORT_PARALLEL_MAX_JOBS of them, each covering at least
+ * COLLATE_SORT_PARALLEL_MIN_KEYS strings.
+ */
+#define COLLATE_SORT_PARALLEL_MIN_KEYS 1024
+#define COLLATE_SORT_PARALLEL_MAX_JOBS 64
+
+typedef struct _CollateSortJob CollateSortJob;
+
+struct _CollateSortJob {
+        const UTFCollator *collator;
+        CollateSortKey *keys;
+        size_t n;
+        CollateKeyBuffers buffers;
+};
+
+/* {{{1
+ * Generate the sort keys of ‘job’ under normalize_guard().  If we run out of
+ * memory, the keys that are still missing are left for collate_sort_keys(),
+ * which can raise NoMemError properly once all the workers are done.
+ */
+static void
+collate_sort_job_run(void *closure)
+{
+        CollateSortJob *job = closure;
+
+        collate_sort_keys_generate(job->collator, &job->buffers, job->keys,
+                                   job->n);
+}
+
+static void *
+collate_sort_job_worker(void *closure)
+{
+        normalize_guard(collate_sort_job_run, closure);
+
+        return NULL;
+}
+
+/* {{{1
+ * Generate the sort keys of ‘keys’ in parallel, unless there aren’t enough of
+ * them to be worth it.  As with utf_normalize_parallel(), the main thread
+ * takes the first job, and any job that it couldn’t start a thread for,
+ * under normalize_guard(), so that nothing can raise while the workers are
+ * running.  The workers never call into Ruby and block all signals.
+ */
+static void
+collate_sort_keys_generate_parallel(const UTFCollator *collator,
+                                    CollateSortKey *keys, size_t n)
+{
+        long n_processors = sysconf(_SC_NPROCESSORS_ONLN);
+        size_t n_jobs = n / COLLATE_SORT_PARALLEL_MIN_KEYS;
+        if (n_processors > 0 && (size_t)n_processors < n_jobs)
+                n_jobs = n_processors;
+        if (n_jobs > COLLATE_SORT_PARALLEL_MAX_JOBS)
+                n_jobs = COLLATE_SORT_PARALLEL_MAX_JOBS;
+        if (n_processors < 2 || n_jobs < 2)
+                return;
+
+        CollateSortJob jobs[COLLATE_SORT_PARALLEL_MAX_JOBS];
+        for (size_t i = 0; i < n_jobs; i++) {
+                jobs[i].collator = collator;
+                jobs[i].keys = keys + i * (n / n_jobs);
+                jobs[i].n = (i < n_jobs - 1) ? n / n_jobs : n - i * (n / n_jobs);
+                collate_key_buffers_init(&jobs[i].buffers);
+        }
+
+        sigset_t all_signals, signals;
+        sigfillset(&all_signals);
+        pthread_sigmask(SIG_SETMASK, &all_signals, &signals);
+        pthread_t threads[COLLATE_SORT_PARALLEL_MAX_JOBS];
+        bool started[COLLATE_SORT_PARALLEL_MAX_JOBS];
+        for (size_t i = 1; i < n_jobs; i++)
+                started[i] = pthread_create(&threads[i], NULL,
+                                            collate_sort_job_worker,
+                                            &jobs[i]) == 0;
+        pthread_sigmask(SIG_SETMASK, &signals, NULL);
+
+        normalize_guard(collate_sort_job_run, &jobs[0]);
+
+        for (size_t i = 1; i < n_jobs; i++)
+                if (started[i])
+                        pthread_join(threads[i], NULL);
+
+        for (size_t i = 1; i < n_jobs; i++)
+                if (!started[i])
+                        normalize_guard(collate_sort_job_run, &jobs[i]);
+
+        for (size_t i = 0; i < n_jobs; i++)
+                collate_key_buffers_free(&jobs[i].buffers);
+}
+#endif
+
+
+/* {{{1
+ * The byte of the sort key of ‘sort_key’ at ‘depth’ plus one, or 0 past its end,
+ * so that a key sorts before the keys that it is a prefix of.
+ */
+#define SORT_KEY_BYTE(sort_key, depth) \
+        (((depth) < (sort_key)->key_len) ? \
+         (int)(unsigned char)(sort_key)->key[depth] + 1 : 0)
+
+#define COLLATE_SORT_INSERTION_MAX 12
+
+static inline void
+collate_sort_key_swap(CollateSortKey *a, CollateSortKey *b)
+{
+        CollateSortKey tmp = *a;
+        *a = *b;
+        *b = tmp;
+}
+
+/* {{{1
+ * Compare two sort keys that are known to agree on their first ‘depth’
+ * bytes.  Equal keys are ordered by their index, so that the sort is stable.
+ */
+static int
+collate_sort_key_compare(const CollateSortKey *a, const CollateSortKey *b,
+                         size_t depth)
+{
+        size_t a_len = a->key_len - depth;
+        size_t b_len = b->key_len - depth;
+        int result = memcmp(a->key + depth, b->key + depth,
+                            (a_len < b_len) ? a_len : b_len);
+        if (result != 0)
+                return result;
+        if (a_len != b_len)
+                return (a_len < b_len) ? -1 : 1;
+
+        return (a->index < b->index) ? -1 : (a->index > b->index);
+}
+
+static int
+collate_sort_key_compare_indexes(const void *a, const void *b)
+{
+        long a_index = ((const CollateSortKey *)a)->index;
+        long b_index = ((const CollateSortKey *)b)->index;
+
+        return (a_index < b_index) ? -1 : (a_index > b_index);
+}
+
+/* {{{1
+ * Sort ‘keys’, which agree on their first ‘depth’ bytes, using a multikey
+ * quicksort, that is, a three-way radix quicksort on one byte at a time.
+ * The keys less than and greater than the pivot byte are sorted at the same
+ * depth, while those equal to it are sorted at the next depth.  The two
+ * smaller partitions are sorted recursively and the largest one by the
+ * loop, so that we never recurse more than log n deep, however long the
+ * keys or skewed the pivots.  Small partitions are sorted by insertion.
+ */
+static void
+collate_sort_keys_multikey(CollateSortKey *keys, size_t n, size_t depth)
+{
+        while (n > COLLATE_SORT_INSERTION_MAX) {
+                collate_sort_key_swap(&keys[0], &keys[n / 2]);
+                int pivot = SORT_KEY_BYTE(&keys[0], depth);
+
+                /* Partition into ‘< pivot’, ‘= pivot’, and ‘> pivot’ using
+                 * Dijkstra’s Dutch national flag algorithm. */
+                size_t lt = 0, i = 1, gt = n;
+                while (i < gt) {
+                        int b = SORT_KEY_BYTE(&keys[i], depth);
+                        if (b < pivot)
+                                collate_sort_key_swap(&keys[lt++], &keys[i++]);
+                        else if (b > pivot)
+                                collate_sort_key_swap(&keys[i], &keys[--gt]);
+                        else
+                                i++;
+                }
+
+                size_t n_lt = lt, n_eq = gt - lt, n_gt = n - gt;
+                if (pivot == 0) {
+                        /* These keys have all ended, so they’re equal and
+                         * only their indexes remain to be sorted on. */
+                        qsort(keys + lt, n_eq, sizeof(CollateSortKey),
+                              collate_sort_key_compare_indexes);
+                        n_eq = 0;
+                }
+
+                if (n_eq >= n_lt && n_eq >= n_gt) {
+                        collate_sort_keys_multikey(keys, n_lt, depth);
+                        collate_sort_keys_multikey(keys + gt, n_gt, depth);
+                        keys += lt;
+                        n = n_eq;
+                        depth++;
+                } else if (n_lt >= n_gt) {
+                        collate_sort_keys_multikey(keys + lt, n_eq, depth + 1);
+                        collate_sort_keys_multikey(keys + gt, n_gt, depth);
+                        n = n_lt;
+                } else {
+                        collate_sort_keys_multikey(keys, n_lt, depth);
+                        collate_sort_keys_multikey(keys + lt, n_eq, depth + 1);
+                        keys += gt;
+                        n = n_gt;
+                }
+        }
+
+        for (size_t i = 1; i < n; i++) {
+                CollateSortKey key = keys[i];
+                size_t j = i;
+                for (; j > 0 && collate_sort_key_compare(&keys[j - 1], &key,
+                                                         depth) > 0; j--)
+                        keys[j] = keys[j - 1];
+                keys[j] = key;
+        }
+}
+
+/* {{{1
+ * Sort the strings in ‘keys’ by collation with ‘collator’, or the DUCET if
+ * it’s NULL, generating the sort key of each string once, on several threads
+ * if there are many strings.  Strings that collate equal keep their relative
+ * order.
+ */
+void
+collate_sort_keys(const UTFCollator *collator, CollateSortKey *keys, size_t n)
+{
+        if (collator == NULL)
+                collator = &collate_default;
+
+        CollateKeyBuffers buffers;
+        collate_key_buffers_init(&buffers);
+
+#ifdef HAVE_PTHREAD_H
+        if (n >= 2 * COLLATE_SORT_PARALLEL_MIN_KEYS)
+                collate_sort_keys_generate_parallel(collator, keys, n);
+#endif
+        /* Generate any keys that weren’t, including those of jobs that ran
+         * out of memory. */
+        collate_sort_keys_generate(collator, &buffers, keys, n);
+
+        collate_sort_keys_multikey(keys, n, 0);
+}
@@ -13997,6 +13997,587 @@ static const struct {
 	{ 0xfb16, "\xd5\xbe\xd5\xb6" },
 	{ 0xfb17, "\xd5\xb4\xd5\xad" },
 };
+
+
+/*
+ * Index into casefold_table: one more than the index of the entry for a
+ * character, or 0 if it has none.
+ */
+static const uint16_t casefold_index_data[][256] = {
+	{ /* page 0, index 0 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 
+	},
+	{ /* page 1, index 1 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 
+	},
+	{ /* page 3, index 2 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 11, 
+		12, 0, 0, 0, 13, 14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 15, 16, 0, 0, 0, 17, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 
+	},
+	{ /* page 5, index 3 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 
+	},
+	{ /* page 30, index 4 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 19, 20, 21, 22, 23, 24, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 
+	},
+	{ /* page 31, index 5 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 25, 0, 26, 
+		0, 27, 0, 28, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 
+		41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 
+		56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 
+		71, 72, 73, 74, 75, 76, 0, 0, 77, 78, 79, 0, 80, 81, 0, 0, 0, 
+		0, 82, 0, 83, 0, 0, 0, 84, 85, 86, 0, 87, 88, 0, 0, 0, 0, 89, 
+		0, 0, 0, 0, 0, 90, 91, 0, 0, 92, 93, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 94, 95, 96, 0, 97, 98, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 99, 
+		100, 101, 0, 102, 103, 0, 0, 0, 0, 104, 0, 0, 0, 
+	},
+	{ /* page 33, index 6 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 105, 106, 107, 108, 109, 
+		110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+	},
+	{ /* page 36, index 7 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 121, 122, 123, 124, 
+		125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 
+		137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 
+	},
+	{ /* page 251, index 8 */
+		147, 148, 149, 150, 151, 152, 153, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 154, 155, 156, 157, 158, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+	}
+};
+
+
+static const int16_t casefold_index_table[252] = {
+	0 /* page 0 */,
+	1 /* page 1 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	2 /* page 3 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	3 /* page 5 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	4 /* page 30 */,
+	5 /* page 31 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	6 /* page 33 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	7 /* page 36 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	8 /* page 251 */,
+};
+
+/*
+ * Table of casefoldings for U+0000 through U+052F, that is, the Latin, Greek,
+ * and Cyrillic blocks, so that they can be looked up directly.  Characters
+ * that fold to more than one character are marked with
+ * UNICODE_CASEFOLD_DIRECT_MULTIPLE and have to be looked up in
+ * casefold_table.
+ */
+#define UNICODE_CASEFOLD_DIRECT_LAST 0x052f
+
+#define UNICODE_CASEFOLD_DIRECT_MULTIPLE 0xffff
+
+static const uint16_t casefold_direct_table[UNICODE_CASEFOLD_DIRECT_LAST + 1] = {
+	0x0000, 0x0001, 0x0002, 0x0003, 0x0004, 0x0005, 0x0006, 0x0007,
+	0x0008, 0x0009, 0x000a, 0x000b, 0x000c, 0x000d, 0x000e, 0x000f,
+	0x0010, 0x0011, 0x0012, 0x0013, 0x0014, 0x0015, 0x0016, 0x0017,
+	0x0018, 0x0019, 0x001a, 0x001b, 0x001c, 0x001d, 0x001e, 0x001f,
+	0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+	0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+	0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+	0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+	0x0040, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+	0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+	0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+	0x0078, 0x0079, 0x007a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+	0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+	0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+	0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+	0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x007f,
+	0x0080, 0x0081, 0x0082, 0x0083, 0x0084, 0x0085, 0x0086, 0x0087,
+	0x0088, 0x0089, 0x008a, 0x008b, 0x008c, 0x008d, 0x008e, 0x008f,
+	0x0090, 0x0091, 0x0092, 0x0093, 0x0094, 0x0095, 0x0096, 0x0097,
+	0x0098, 0x0099, 0x009a, 0x009b, 0x009c, 0x009d, 0x009e, 0x009f,
+	0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+	0x00a8, 0x00a9, 0x00aa, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+	0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x03bc, 0x00b6, 0x00b7,
+	0x00b8, 0x00b9, 0x00ba, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00bf,
+	0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+	0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+	0x00f0, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x00d7,
+	0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x00fd, 0x00fe, 0xffff,
+	0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+	0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+	0x00f0, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x00f7,
+	0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x00fd, 0x00fe, 0x00ff,
+	0x0101, 0x0101, 0x0103, 0x0103, 0x0105, 0x0105, 0x0107, 0x0107,
+	0x0109, 0x0109, 0x010b, 0x010b, 0x010d, 0x010d, 0x010f, 0x010f,
+	0x0111, 0x0111, 0x0113, 0x0113, 0x0115, 0x0115, 0x0117, 0x0117,
+	0x0119, 0x0119, 0x011b, 0x011b, 0x011d, 0x011d, 0x011f, 0x011f,
+	0x0121, 0x0121, 0x0123, 0x0123, 0x0125, 0x0125, 0x0127, 0x0127,
+	0x0129, 0x0129, 0x012b, 0x012b, 0x012d, 0x012d, 0x012f, 0x012f,
+	0xffff, 0x0131, 0x0133, 0x0133, 0x0135, 0x0135, 0x0137, 0x0137,
+	0x0138, 0x013a, 0x013a, 0x013c, 0x013c, 0x013e, 0x013e, 0x0140,
+	0x0140, 0x0142, 0x0142, 0x0144, 0x0144, 0x0146, 0x0146, 0x0148,
+	0x0148, 0xffff, 0x014b, 0x014b, 0x014d, 0x014d, 0x014f, 0x014f,
+	0x0151, 0x0151, 0x0153, 0x0153, 0x0155, 0x0155, 0x0157, 0x0157,
+	0x0159, 0x0159, 0x015b, 0x015b, 0x015d, 0x015d, 0x015f, 0x015f,
+	0x0161, 0x0161, 0x0163, 0x0163, 0x0165, 0x0165, 0x0167, 0x0167,
+	0x0169, 0x0169, 0x016b, 0x016b, 0x016d, 0x016d, 0x016f, 0x016f,
+	0x0171, 0x0171, 0x0173, 0x0173, 0x0175, 0x0175, 0x0177, 0x0177,
+	0x00ff, 0x017a, 0x017a, 0x017c, 0x017c, 0x017e, 0x017e, 0x0073,
+	0x0180, 0x0253, 0x0183, 0x0183, 0x0185, 0x0185, 0x0254, 0x0188,
+	0x0188, 0x0256, 0x0257, 0x018c, 0x018c, 0x018d, 0x01dd, 0x0259,
+	0x025b, 0x0192, 0x0192, 0x0260, 0x0263, 0x0195, 0x0269, 0x0268,
+	0x0199, 0x0199, 0x019a, 0x019b, 0x026f, 0x0272, 0x019e, 0x0275,
+	0x01a1, 0x01a1, 0x01a3, 0x01a3, 0x01a5, 0x01a5, 0x0280, 0x01a8,
+	0x01a8, 0x0283, 0x01aa, 0x01ab, 0x01ad, 0x01ad, 0x0288, 0x01b0,
+	0x01b0, 0x028a, 0x028b, 0x01b4, 0x01b4, 0x01b6, 0x01b6, 0x0292,
+	0x01b9, 0x01b9, 0x01ba, 0x01bb, 0x01bd, 0x01bd, 0x01be, 0x01bf,
+	0x01c0, 0x01c1, 0x01c2, 0x01c3, 0x01c6, 0x01c6, 0x01c6, 0x01c9,
+	0x01c9, 0x01c9, 0x01cc, 0x01cc, 0x01cc, 0x01ce, 0x01ce, 0x01d0,
+	0x01d0, 0x01d2, 0x01d2, 0x01d4, 0x01d4, 0x01d6, 0x01d6, 0x01d8,
+	0x01d8, 0x01da, 0x01da, 0x01dc, 0x01dc, 0x01dd, 0x01df, 0x01df,
+	0x01e1, 0x01e1, 0x01e3, 0x01e3, 0x01e5, 0x01e5, 0x01e7, 0x01e7,
+	0x01e9, 0x01e9, 0x01eb, 0x01eb, 0x01ed, 0x01ed, 0x01ef, 0x01ef,
+	0xffff, 0x01f3, 0x01f3, 0x01f3, 0x01f5, 0x01f5, 0x0195, 0x01bf,
+	0x01f9, 0x01f9, 0x01fb, 0x01fb, 0x01fd, 0x01fd, 0x01ff, 0x01ff,
+	0x0201, 0x0201, 0x0203, 0x0203, 0x0205, 0x0205, 0x0207, 0x0207,
+	0x0209, 0x0209, 0x020b, 0x020b, 0x020d, 0x020d, 0x020f, 0x020f,
+	0x0211, 0x0211, 0x0213, 0x0213, 0x0215, 0x0215, 0x0217, 0x0217,
+	0x0219, 0x0219, 0x021b, 0x021b, 0x021d, 0x021d, 0x021f, 0x021f,
+	0x019e, 0x0221, 0x0223, 0x0223, 0x0225, 0x0225, 0x0227, 0x0227,
+	0x0229, 0x0229, 0x022b, 0x022b, 0x022d, 0x022d, 0x022f, 0x022f,
+	0x0231, 0x0231, 0x0233, 0x0233, 0x0234, 0x0235, 0x0236, 0x0237,
+	0x0238, 0x0239, 0x2c65, 0x023c, 0x023c, 0x019a, 0x2c66, 0x023f,
+	0x0240, 0x0242, 0x0242, 0x0180, 0x0289, 0x028c, 0x0247, 0x0247,
+	0x0249, 0x0249, 0x024b, 0x024b, 0x024d, 0x024d, 0x024f, 0x024f,
+	0x0250, 0x0251, 0x0252, 0x0253, 0x0254, 0x0255, 0x0256, 0x0257,
+	0x0258, 0x0259, 0x025a, 0x025b, 0x025c, 0x025d, 0x025e, 0x025f,
+	0x0260, 0x0261, 0x0262, 0x0263, 0x0264, 0x0265, 0x0266, 0x0267,
+	0x0268, 0x0269, 0x026a, 0x026b, 0x026c, 0x026d, 0x026e, 0x026f,
+	0x0270, 0x0271, 0x0272, 0x0273, 0x0274, 0x0275, 0x0276, 0x0277,
+	0x0278, 0x0279, 0x027a, 0x027b, 0x027c, 0x027d, 0x027e, 0x027f,
+	0x0280, 0x0281, 0x0282, 0x0283, 0x0284, 0x0285, 0x0286, 0x0287,
+	0x0288, 0x0289, 0x028a, 0x028b, 0x028c, 0x028d, 0x028e, 0x028f,
+	0x0290, 0x0291, 0x0292, 0x0293, 0x0294, 0x0295, 0x0296, 0x0297,
+	0x0298, 0x0299, 0x029a, 0x029b, 0x029c, 0x029d, 0x029e, 0x029f,
+	0x02a0, 0x02a1, 0x02a2, 0x02a3, 0x02a4, 0x02a5, 0x02a6, 0x02a7,
+	0x02a8, 0x02a9, 0x02aa, 0x02ab, 0x02ac, 0x02ad, 0x02ae, 0x02af,
+	0x02b0, 0x02b1, 0x02b2, 0x02b3, 0x02b4, 0x02b5, 0x02b6, 0x02b7,
+	0x02b8, 0x02b9, 0x02ba, 0x02bb, 0x02bc, 0x02bd, 0x02be, 0x02bf,
+	0x02c0, 0x02c1, 0x02c2, 0x02c3, 0x02c4, 0x02c5, 0x02c6, 0x02c7,
+	0x02c8, 0x02c9, 0x02ca, 0x02cb, 0x02cc, 0x02cd, 0x02ce, 0x02cf,
+	0x02d0, 0x02d1, 0x02d2, 0x02d3, 0x02d4, 0x02d5, 0x02d6, 0x02d7,
+	0x02d8, 0x02d9, 0x02da, 0x02db, 0x02dc, 0x02dd, 0x02de, 0x02df,
+	0x02e0, 0x02e1, 0x02e2, 0x02e3, 0x02e4, 0x02e5, 0x02e6, 0x02e7,
+	0x02e8, 0x02e9, 0x02ea, 0x02eb, 0x02ec, 0x02ed, 0x02ee, 0x02ef,
+	0x02f0, 0x02f1, 0x02f2, 0x02f3, 0x02f4, 0x02f5, 0x02f6, 0x02f7,
+	0x02f8, 0x02f9, 0x02fa, 0x02fb, 0x02fc, 0x02fd, 0x02fe, 0x02ff,
+	0x0300, 0x0301, 0x0302, 0x0303, 0x0304, 0x0305, 0x0306, 0x0307,
+	0x0308, 0x0309, 0x030a, 0x030b, 0x030c, 0x030d, 0x030e, 0x030f,
+	0x0310, 0x0311, 0x0312, 0x0313, 0x0314, 0x0315, 0x0316, 0x0317,
+	0x0318, 0x0319, 0x031a, 0x031b, 0x031c, 0x031d, 0x031e, 0x031f,
+	0x0320, 0x0321, 0x0322, 0x0323, 0x0324, 0x0325, 0x0326, 0x0327,
+	0x0328, 0x0329, 0x032a, 0x032b, 0x032c, 0x032d, 0x032e, 0x032f,
+	0x0330, 0x0331, 0x0332, 0x0333, 0x0334, 0x0335, 0x0336, 0x0337,
+	0x0338, 0x0339, 0x033a, 0x033b, 0x033c, 0x033d, 0x033e, 0x033f,
+	0x0340, 0x0341, 0x0342, 0x0343, 0x0344, 0x03b9, 0x0346, 0x0347,
+	0x0348, 0x0349, 0x034a, 0x034b, 0x034c, 0x034d, 0x034e, 0x034f,
+	0x0350, 0x0351, 0x0352, 0x0353, 0x0354, 0x0355, 0x0356, 0x0357,
+	0x0358, 0x0359, 0x035a, 0x035b, 0x035c, 0x035d, 0x035e, 0x035f,
+	0x0360, 0x0361, 0x0362, 0x0363, 0x0364, 0x0365, 0x0366, 0x0367,
+	0x0368, 0x0369, 0x036a, 0x036b, 0x036c, 0x036d, 0x036e, 0x036f,
+	0x0370, 0x0371, 0x0372, 0x0373, 0x0374, 0x0375, 0x0376, 0x0377,
+	0x0378, 0x0379, 0x037a, 0x037b, 0x037c, 0x037d, 0x037e, 0x037f,
+	0x0380, 0x0381, 0x0382, 0x0383, 0x0384, 0x0385, 0x03ac, 0x0387,
+	0x03ad, 0x03ae, 0x03af, 0x038b, 0x03cc, 0x038d, 0x03cd, 0x03ce,
+	0xffff, 0x03b1, 0x03b2, 0x03b3, 0x03b4, 0x03b5, 0x03b6, 0x03b7,
+	0x03b8, 0x03b9, 0x03ba, 0x03bb, 0x03bc, 0x03bd, 0x03be, 0x03bf,
+	0x03c0, 0x03c1, 0x03a2, 0x03c3, 0x03c4, 0x03c5, 0x03c6, 0x03c7,
+	0x03c8, 0x03c9, 0x03ca, 0x03cb, 0x03ac, 0x03ad, 0x03ae, 0x03af,
+	0xffff, 0x03b1, 0x03b2, 0x03b3, 0x03b4, 0x03b5, 0x03b6, 0x03b7,
+	0x03b8, 0x03b9, 0x03ba, 0x03bb, 0x03bc, 0x03bd, 0x03be, 0x03bf,
+	0x03c0, 0x03c1, 0x03c3, 0x03c3, 0x03c4, 0x03c5, 0x03c6, 0x03c7,
+	0x03c8, 0x03c9, 0x03ca, 0x03cb, 0x03cc, 0x03cd, 0x03ce, 0x03cf,
+	0x03b2, 0x03b8, 0x03d2, 0x03d3, 0x03d4, 0x03c6, 0x03c0, 0x03d7,
+	0x03d9, 0x03d9, 0x03db, 0x03db, 0x03dd, 0x03dd, 0x03df, 0x03df,
+	0x03e1, 0x03e1, 0x03e3, 0x03e3, 0x03e5, 0x03e5, 0x03e7, 0x03e7,
+	0x03e9, 0x03e9, 0x03eb, 0x03eb, 0x03ed, 0x03ed, 0x03ef, 0x03ef,
+	0x03ba, 0x03c1, 0x03f2, 0x03f3, 0x03b8, 0x03b5, 0x03f6, 0x03f8,
+	0x03f8, 0x03f2, 0x03fb, 0x03fb, 0x03fc, 0x037b, 0x037c, 0x037d,
+	0x0450, 0x0451, 0x0452, 0x0453, 0x0454, 0x0455, 0x0456, 0x0457,
+	0x0458, 0x0459, 0x045a, 0x045b, 0x045c, 0x045d, 0x045e, 0x045f,
+	0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437,
+	0x0438, 0x0439, 0x043a, 0x043b, 0x043c, 0x043d, 0x043e, 0x043f,
+	0x0440, 0x0441, 0x0442, 0x0443, 0x0444, 0x0445, 0x0446, 0x0447,
+	0x0448, 0x0449, 0x044a, 0x044b, 0x044c, 0x044d, 0x044e, 0x044f,
+	0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437,
+	0x0438, 0x0439, 0x043a, 0x043b, 0x043c, 0x043d, 0x043e, 0x043f,
+	0x0440, 0x0441, 0x0442, 0x0443, 0x0444, 0x0445, 0x0446, 0x0447,
+	0x0448, 0x0449, 0x044a, 0x044b, 0x044c, 0x044d, 0x044e, 0x044f,
+	0x0450, 0x0451, 0x0452, 0x0453, 0x0454, 0x0455, 0x0456, 0x0457,
+	0x0458, 0x0459, 0x045a, 0x045b, 0x045c, 0x045d, 0x045e, 0x045f,
+	0x0461, 0x0461, 0x0463, 0x0463, 0x0465, 0x0465, 0x0467, 0x0467,
+	0x0469, 0x0469, 0x046b, 0x046b, 0x046d, 0x046d, 0x046f, 0x046f,
+	0x0471, 0x0471, 0x0473, 0x0473, 0x0475, 0x0475, 0x0477, 0x0477,
+	0x0479, 0x0479, 0x047b, 0x047b, 0x047d, 0x047d, 0x047f, 0x047f,
+	0x0481, 0x0481, 0x0482, 0x0483, 0x0484, 0x0485, 0x0486, 0x0487,
+	0x0488, 0x0489, 0x048b, 0x048b, 0x048d, 0x048d, 0x048f, 0x048f,
+	0x0491, 0x0491, 0x0493, 0x0493, 0x0495, 0x0495, 0x0497, 0x0497,
+	0x0499, 0x0499, 0x049b, 0x049b, 0x049d, 0x049d, 0x049f, 0x049f,
+	0x04a1, 0x04a1, 0x04a3, 0x04a3, 0x04a5, 0x04a5, 0x04a7, 0x04a7,
+	0x04a9, 0x04a9, 0x04ab, 0x04ab, 0x04ad, 0x04ad, 0x04af, 0x04af,
+	0x04b1, 0x04b1, 0x04b3, 0x04b3, 0x04b5, 0x04b5, 0x04b7, 0x04b7,
+	0x04b9, 0x04b9, 0x04bb, 0x04bb, 0x04bd, 0x04bd, 0x04bf, 0x04bf,
+	0x04cf, 0x04c2, 0x04c2, 0x04c4, 0x04c4, 0x04c6, 0x04c6, 0x04c8,
+	0x04c8, 0x04ca, 0x04ca, 0x04cc, 0x04cc, 0x04ce, 0x04ce, 0x04cf,
+	0x04d1, 0x04d1, 0x04d3, 0x04d3, 0x04d5, 0x04d5, 0x04d7, 0x04d7,
+	0x04d9, 0x04d9, 0x04db, 0x04db, 0x04dd, 0x04dd, 0x04df, 0x04df,
+	0x04e1, 0x04e1, 0x04e3, 0x04e3, 0x04e5, 0x04e5, 0x04e7, 0x04e7,
+	0x04e9, 0x04e9, 0x04eb, 0x04eb, 0x04ed, 0x04ed, 0x04ef, 0x04ef,
+	0x04f1, 0x04f1, 0x04f3, 0x04f3, 0x04f5, 0x04f5, 0x04f7, 0x04f7,
+	0x04f9, 0x04f9, 0x04fb, 0x04fb, 0x04fd, 0x04fd, 0x04ff, 0x04ff,
+	0x0501, 0x0501, 0x0503, 0x0503, 0x0505, 0x0505, 0x0507, 0x0507,
+	0x0509, 0x0509, 0x050b, 0x050b, 0x050d, 0x050d, 0x050f, 0x050f,
+	0x0511, 0x0511, 0x0513, 0x0513, 0x0514, 0x0515, 0x0516, 0x0517,
+	0x0518, 0x0519, 0x051a, 0x051b, 0x051c, 0x051d, 0x051e, 0x051f,
+	0x0520, 0x0521, 0x0522, 0x0523, 0x0524, 0x0525, 0x0526, 0x0527,
+	0x0528, 0x0529, 0x052a, 0x052b, 0x052c, 0x052d, 0x052e, 0x052f,
+};
 static const struct {
 	unichar ch;
 	unichar mirrored_ch;
@@ -14355,4 +14936,474 @@ static const struct {
 	{ 0xff63, 0xff62 },
 };
 
+
+/*
+ * Index into bidi_mirroring_table: one more than the index of the entry for a
+ * character, or 0 if it has none.
+ */
+static const uint16_t bidi_mirroring_index_data[][256] = {
+	{ /* page 0, index 0 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 4, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 5, 0, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 8, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 
+	},
+	{ /* page 15, index 1 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 11, 12, 13, 
+		14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 
+	},
+	{ /* page 22, index 2 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 15, 16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 
+	},
+	{ /* page 32, index 3 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 17, 18, 0, 0, 19, 20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 21, 22, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 24, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 25, 26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 27, 
+		28, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+	},
+	{ /* page 34, index 4 */
+		0, 0, 0, 0, 0, 0, 0, 0, 29, 30, 31, 32, 33, 34, 0, 0, 0, 0, 0, 
+		0, 0, 35, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		36, 37, 0, 0, 0, 0, 0, 38, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 39, 40, 41, 42, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 43, 44, 45, 46, 47, 48, 49, 50, 0, 0, 51, 52, 53, 54, 55, 
+		56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 
+		71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 0, 0, 0, 81, 82, 83, 
+		84, 0, 0, 0, 0, 0, 85, 0, 0, 0, 0, 0, 0, 0, 0, 0, 86, 87, 0, 
+		0, 88, 0, 89, 90, 0, 91, 0, 0, 0, 0, 92, 93, 94, 95, 96, 97, 
+		98, 99, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		100, 101, 102, 103, 104, 0, 0, 105, 106, 0, 0, 0, 0, 107, 108, 
+		109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 
+		121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 0, 0, 131, 
+		132, 133, 134, 135, 0, 136, 137, 0, 0, 138, 139, 140, 141, 
+		142, 0, 
+	},
+	{ /* page 35, index 5 */
+		0, 0, 0, 0, 0, 0, 0, 0, 143, 144, 145, 146, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 147, 148, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 
+	},
+	{ /* page 39, index 6 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 
+		161, 162, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 163, 
+		164, 165, 166, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 167, 
+		168, 0, 0, 0, 0, 0, 0, 169, 170, 0, 0, 0, 171, 172, 173, 174, 
+		175, 176, 177, 178, 179, 180, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 
+	},
+	{ /* page 41, index 7 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 181, 182, 183, 184, 185, 186, 187, 188, 189, 
+		190, 191, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 
+		202, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 203, 0, 0, 0, 0, 0, 0, 0, 
+		204, 205, 0, 0, 206, 207, 0, 0, 0, 0, 0, 0, 0, 0, 0, 208, 209, 
+		210, 211, 0, 212, 213, 0, 0, 214, 215, 216, 217, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		218, 0, 0, 219, 220, 0, 0, 221, 222, 0, 0, 
+	},
+	{ /* page 42, index 8 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 223, 224, 225, 226, 0, 0, 0, 0, 0, 227, 228, 0, 0, 0, 0, 0, 
+		0, 229, 230, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 231, 232, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 233, 234, 0, 0, 235, 236, 237, 238, 239, 240, 241, 
+		242, 0, 0, 0, 0, 0, 0, 243, 244, 0, 0, 0, 0, 245, 246, 247, 
+		248, 249, 250, 251, 252, 253, 254, 255, 256, 0, 0, 0, 0, 257, 
+		258, 0, 0, 0, 259, 260, 261, 262, 263, 264, 265, 266, 0, 267, 
+		268, 0, 0, 269, 270, 0, 0, 0, 0, 0, 0, 271, 272, 273, 274, 
+		275, 276, 277, 278, 279, 280, 281, 282, 0, 0, 0, 0, 0, 0, 283, 
+		284, 285, 286, 287, 288, 289, 290, 291, 292, 0, 0, 0, 0, 0, 0, 
+		0, 293, 0, 0, 0, 0, 294, 295, 296, 0, 0, 0, 0, 0, 0, 297, 298, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 299, 300, 301, 302, 0, 0, 0, 0, 0, 
+	},
+	{ /* page 46, index 9 */
+		0, 0, 303, 304, 305, 306, 0, 0, 0, 307, 308, 0, 309, 310, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 311, 312, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+	},
+	{ /* page 48, index 10 */
+		0, 0, 0, 0, 0, 0, 0, 0, 313, 314, 315, 316, 317, 318, 319, 
+		320, 321, 322, 0, 0, 323, 324, 325, 326, 327, 328, 329, 330, 
+		0, 331, 332, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+	},
+	{ /* page 254, index 11 */
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 333, 334, 335, 336, 337, 338, 0, 0, 0, 0, 0, 
+		339, 340, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+	},
+	{ /* page 255, index 12 */
+		0, 0, 0, 0, 0, 0, 0, 0, 341, 342, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 343, 0, 344, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		345, 0, 346, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 347, 0, 348, 0, 349, 
+		350, 0, 351, 352, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+	}
+};
+
+
+static const int16_t bidi_mirroring_index_table[256] = {
+	0 /* page 0 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	1 /* page 15 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	2 /* page 22 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	3 /* page 32 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	4 /* page 34 */,
+	5 /* page 35 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	6 /* page 39 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	7 /* page 41 */,
+	8 /* page 42 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	9 /* page 46 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	10 /* page 48 */,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	0 + UNICODE_MAX_TABLE_INDEX,
+	11 /* page 254 */,
+	12 /* page 255 */,
+};
+
 #endif /* CHARACTER_TABLES_H */
@@ -4,1603 +4,2136 @@
 #define COMPOSE_H
 
 
-#define COMPOSE_FIRST_START 1
-#define COMPOSE_FIRST_SINGLE_START 147
-#define COMPOSE_SECOND_START 368
-#define COMPOSE_SECOND_SINGLE_START 399
-#define COMPOSE_TABLE_LAST 48
+#define COMPOSE_PAIR_BUCKET_BITS 9
+#define COMPOSE_PAIR_SLOT_BITS 11
 
-
-static const uint16_t compose_data[][256] = {
-	{ /* page 0, index 0 */
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 147, 
-		148, 149, 0, 0, 1, 2, 3, 4, 5, 150, 6, 7, 8, 151, 9, 10, 11, 
-		12, 13, 14, 0, 15, 16, 17, 18, 19, 20, 21, 22, 23, 0, 0, 0, 0, 
-		0, 0, 24, 25, 26, 27, 28, 152, 29, 30, 31, 32, 33, 34, 35, 36, 
-		37, 38, 0, 39, 40, 41, 42, 43, 44, 45, 46, 47, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 48, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 49, 0, 153, 154, 50, 155, 0, 0, 51, 0, 0, 0, 0, 
-		156, 0, 0, 0, 0, 52, 53, 157, 0, 158, 0, 0, 0, 54, 0, 0, 0, 0, 
-		0, 55, 0, 159, 160, 56, 161, 0, 0, 57, 0, 0, 0, 0, 162, 0, 0, 
-		0, 0, 58, 59, 163, 0, 164, 0, 0, 0, 60, 0, 0, 0, 
-	},
-	{ /* page 1, index 1 */
-		0, 0, 61, 62, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 63, 
-		64, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 65, 66, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 165, 166, 0, 0, 0, 0, 167, 168, 
-		0, 0, 0, 0, 0, 0, 169, 170, 171, 172, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 173, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 67, 68, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 69, 
-		70, 0, 0, 0, 0, 0, 0, 174, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 175, 176, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 2, index 2 */
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 177, 178, 
-		179, 180, 0, 0, 0, 0, 181, 182, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 183, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 3, index 3 */
-		368, 369, 370, 371, 372, 0, 373, 374, 375, 376, 377, 378, 379, 
-		0, 0, 380, 0, 381, 0, 382, 383, 0, 0, 0, 0, 0, 0, 384, 0, 0, 
-		0, 0, 0, 0, 0, 385, 386, 387, 388, 389, 390, 0, 0, 0, 0, 391, 
-		392, 0, 393, 394, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 395, 0, 0, 396, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 71, 
-		0, 0, 0, 72, 0, 73, 0, 74, 0, 0, 0, 0, 0, 75, 0, 184, 0, 0, 0, 
-		76, 0, 0, 0, 77, 0, 0, 185, 0, 186, 0, 0, 78, 0, 0, 0, 79, 0, 
-		80, 0, 81, 0, 0, 0, 0, 0, 82, 0, 83, 0, 0, 0, 84, 0, 0, 0, 85, 
-		86, 87, 0, 0, 187, 0, 0, 0, 88, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 4, index 4 */
-		0, 0, 0, 0, 0, 0, 188, 0, 0, 0, 0, 0, 0, 0, 0, 0, 89, 0, 0, 
-		189, 0, 90, 91, 190, 92, 0, 191, 0, 0, 0, 192, 0, 0, 0, 0, 93, 
-		0, 0, 0, 193, 0, 0, 0, 194, 0, 195, 0, 0, 94, 0, 0, 196, 0, 
-		95, 96, 197, 97, 0, 198, 0, 0, 0, 199, 0, 0, 0, 0, 98, 0, 0, 
-		0, 200, 0, 0, 0, 201, 0, 202, 0, 0, 0, 0, 0, 0, 0, 0, 203, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 204, 205, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 206, 207, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 208, 209, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 6, index 5 */
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 99, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 210, 0, 211, 0, 0, 0, 0, 0, 0, 
-		0, 0, 399, 400, 401, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 212, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 213, 0, 0, 214, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 9, index 6 */
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 215, 
-		0, 0, 0, 0, 0, 0, 0, 216, 0, 0, 217, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 402, 0, 0, 0, 0, 0, 0, 0, 0, 100, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 403, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 11, index 7 */
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		404, 0, 0, 0, 0, 0, 0, 0, 0, 101, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 405, 406, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 218, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 407, 0, 0, 0, 0, 0, 0, 0, 102, 219, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 408, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 12, index 8 */
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 220, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 221, 0, 0, 409, 0, 0, 0, 103, 0, 0, 0, 222, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 410, 411, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 13, index 9 */
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		412, 0, 0, 0, 0, 0, 0, 0, 104, 223, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 413, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 414, 0, 0, 
-		0, 0, 415, 0, 0, 0, 0, 0, 0, 0, 0, 0, 105, 0, 0, 224, 0, 0, 
-		416, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 16, index 10 */
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 225, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 
-	},
-	{ /* page 27, index 11 */
-		0, 0, 0, 0, 0, 226, 0, 227, 0, 228, 0, 229, 0, 230, 0, 0, 0, 
-		231, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		232, 0, 233, 0, 234, 235, 0, 0, 236, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 30, index 12 */
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 237, 238, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 239, 240, 0, 0, 0, 0, 0, 0, 241, 242, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 106, 
-		107, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 243, 244, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 245, 246, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 31, index 13 */
-		108, 109, 247, 248, 249, 250, 251, 252, 110, 111, 253, 254, 
-		255, 256, 257, 258, 112, 113, 0, 0, 0, 0, 0, 0, 114, 115, 0, 
-		0, 0, 0, 0, 0, 116, 117, 259, 260, 261, 262, 263, 264, 118, 
-		119, 265, 266, 267, 268, 269, 270, 120, 121, 0, 0, 0, 0, 0, 0, 
-		122, 123, 0, 0, 0, 0, 0, 0, 124, 125, 0, 0, 0, 0, 0, 0, 126, 
-		127, 0, 0, 0, 0, 0, 0, 128, 129, 0, 0, 0, 0, 0, 0, 0, 130, 0, 
-		0, 0, 0, 0, 0, 131, 132, 271, 272, 273, 274, 275, 276, 133, 
-		134, 277, 278, 279, 280, 281, 282, 283, 0, 0, 0, 284, 0, 0, 0, 
-		0, 0, 0, 0, 285, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		286, 0, 0, 0, 0, 0, 0, 0, 0, 135, 0, 0, 0, 0, 0, 0, 287, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 288, 0, 0, 0, 0, 0, 0, 0, 136, 0, 
-	},
-	{ /* page 33, index 14 */
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 289, 0, 
-		290, 0, 291, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 292, 0, 293, 0, 294, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 34, index 15 */
-		0, 0, 0, 295, 0, 0, 0, 0, 296, 0, 0, 297, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 298, 0, 299, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 300, 0, 0, 0, 0, 0, 0, 301, 0, 302, 0, 0, 303, 0, 0, 0, 0, 
-		304, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		305, 0, 0, 306, 307, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 308, 
-		309, 0, 0, 310, 311, 0, 0, 312, 313, 314, 315, 0, 0, 0, 0, 
-		316, 317, 0, 0, 318, 319, 0, 0, 0, 0, 0, 0, 0, 0, 0, 320, 321, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 322, 0, 0, 0, 0, 
-		0, 323, 324, 0, 325, 0, 0, 0, 0, 0, 0, 326, 327, 328, 329, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-	},
-	{ /* page 48, index 16 */
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 330, 0, 0, 0, 0, 331, 0, 332, 0, 333, 0, 
-		334, 0, 335, 0, 336, 0, 337, 0, 338, 0, 339, 0, 340, 0, 341, 
-		0, 342, 0, 0, 343, 0, 344, 0, 345, 0, 0, 0, 0, 0, 0, 137, 0, 
-		0, 138, 0, 0, 139, 0, 0, 140, 0, 0, 141, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 397, 398, 0, 0, 346, 0, 0, 0, 0, 0, 0, 0, 0, 347, 0, 0, 0, 
-		0, 348, 0, 349, 0, 350, 0, 351, 0, 352, 0, 353, 0, 354, 0, 
-		355, 0, 356, 0, 357, 0, 358, 0, 359, 0, 0, 360, 0, 361, 0, 
-		362, 0, 0, 0, 0, 0, 0, 142, 0, 0, 143, 0, 0, 144, 0, 0, 145, 
-		0, 0, 146, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-		0, 0, 363, 364, 365, 366, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 367, 
-		0, 0, 
-	}
-};
-
-
-static const int16_t compose_table[COMPOSE_TABLE_LAST + 1] = {
-	0 /* page 0 */,
-	1 /* page 1 */,
-	2 /* page 2 */,
-	3 /* page 3 */,
-	4 /* page 4 */,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	5 /* page 6 */,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	6 /* page 9 */,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	7 /* page 11 */,
-	8 /* page 12 */,
-	9 /* page 13 */,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	10 /* page 16 */,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	11 /* page 27 */,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	12 /* page 30 */,
-	13 /* page 31 */,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	14 /* page 33 */,
-	15 /* page 34 */,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	0 + UNICODE_MAX_TABLE_INDEX,
-	16 /* page 48 */,
-};
-
-
-static const uint16_t compose_first_single[][2] = {
-	{ 0x0338, 0x226e },
-	{ 0x0338, 0x2260 },
-	{ 0x0338, 0x226f },
-	{ 0x0307, 0x1e1e },
-	{ 0x0302, 0x0134 },
-	{ 0x0307, 0x1e1f },
-	{ 0x0304, 0x01de },
-	{ 0x0301, 0x01fa },
-	{ 0x0301, 0x1e08 },
-	{ 0x0301, 0x1e2e },
-	{ 0x0304, 0x022a },
-	{ 0x0301, 0x01fe },
-	{ 0x0304, 0x01df },
-	{ 0x0301, 0x01fb },
-	{ 0x0301, 0x1e09 },
-	{ 0x0301, 0x1e2f },
-	{ 0x0304, 0x022b },
-	{ 0x0301, 0x01ff },
-	{ 0x0307, 0x1e64 },
-	{ 0x0307, 0x1e65 },
-	{ 0x0307, 0x1e66 },
-	{ 0x0307, 0x1e67 },
-	{ 0x0301, 0x1e78 },
-	{ 0x0301, 0x1e79 },
-	{ 0x0308, 0x1e7a },
-	{ 0x0308, 0x1e7b },
-	{ 0x0307, 0x1e9b },
-	{ 0x030c, 0x01ee },
-	{ 0x0304, 0x01ec },
-	{ 0x0304, 0x01ed },
-	{ 0x0304, 0x01e0 },
-	{ 0x0304, 0x01e1 },
-	{ 0x0306, 0x1e1c },
-	{ 0x0306, 0x1e1d },
-	{ 0x0304, 0x0230 },
-	{ 0x0304, 0x0231 },
-	{ 0x030c, 0x01ef },
-	{ 0x0314, 0x1fec },
-	{ 0x0345, 0x1fb4 },
-	{ 0x0345, 0x1fc4 },
-	{ 0x0345, 0x1ff4 },
-	{ 0x0308, 0x0407 },
-	{ 0x0301, 0x0403 },
-	{ 0x0308, 0x04de },
-	{ 0x0301, 0x040c },
-	{ 0x0308, 0x04e6 },
-	{ 0x0308, 0x04f4 },
-	{ 0x0308, 0x04f8 },
-	{ 0x0308, 0x04ec },
-	{ 0x0301, 0x0453 },
-	{ 0x0308, 0x04df },
-	{ 0x0301, 0x045c },
-	{ 0x0308, 0x04e7 },
-	{ 0x0308, 0x04f5 },
-	{ 0x0308, 0x04f9 },
-	{ 0x0308, 0x04ed },
-	{ 0x0308, 0x0457 },
-	{ 0x030f, 0x0476 },
-	{ 0x030f, 0x0477 },
-	{ 0x0308, 0x04da },
-	{ 0x0308, 0x04db },
-	{ 0x0308, 0x04ea },
-	{ 0x0308, 0x04eb },
-	{ 0x0654, 0x0624 },
-	{ 0x0654, 0x0626 },
-	{ 0x0654, 0x06c2 },
-	{ 0x0654, 0x06d3 },
-	{ 0x0654, 0x06c0 },
-	{ 0x093c, 0x0929 },
-	{ 0x093c, 0x0931 },
-	{ 0x093c, 0x0934 },
-	{ 0x0bd7, 0x0b94 },
-	{ 0x0bbe, 0x0bcb },
-	{ 0x0c56, 0x0c48 },
-	{ 0x0cd5, 0x0cc0 },
-	{ 0x0cd5, 0x0ccb },
-	{ 0x0d3e, 0x0d4b },
-	{ 0x0dca, 0x0ddd },
-	{ 0x102e, 0x1026 },
-	{ 0x1b35, 0x1b06 },
-	{ 0x1b35, 0x1b08 },
-	{ 0x1b35, 0x1b0a },
-	{ 0x1b35, 0x1b0c },
-	{ 0x1b35, 0x1b0e },
-	{ 0x1b35, 0x1b12 },
-	{ 0x1b35, 0x1b3b },
-	{ 0x1b35, 0x1b3d },
-	{ 0x1b35, 0x1b40 },
-	{ 0x1b35, 0x1b41 },
-	{ 0x1b35, 0x1b43 },
-	{ 0x0304, 0x1e38 },
-	{ 0x0304, 0x1e39 },
-	{ 0x0304, 0x1e5c },
-	{ 0x0304, 0x1e5d },
-	{ 0x0307, 0x1e68 },
-	{ 0x0307, 0x1e69 },
-	{ 0x0302, 0x1ec6 },
-	{ 0x0302, 0x1ec7 },
-	{ 0x0302, 0x1ed8 },
-	{ 0x0302, 0x1ed9 },
-	{ 0x0345, 0x1f82 },
-	{ 0x0345, 0x1f83 },
-	{ 0x0345, 0x1f84 },
-	{ 0x0345, 0x1f85 },
-	{ 0x0345, 0x1f86 },
-	{ 0x0345, 0x1f87 },
-	{ 0x0345, 0x1f8a },
-	{ 0x0345, 0x1f8b },
-	{ 0x0345, 0x1f8c },
-	{ 0x0345, 0x1f8d },
-	{ 0x0345, 0x1f8e },
-	{ 0x0345, 0x1f8f },
-	{ 0x0345, 0x1f92 },
-	{ 0x0345, 0x1f93 },
-	{ 0x0345, 0x1f94 },
-	{ 0x0345, 0x1f95 },
-	{ 0x0345, 0x1f96 },
-	{ 0x0345, 0x1f97 },
-	{ 0x0345, 0x1f9a },
-	{ 0x0345, 0x1f9b },
-	{ 0x0345, 0x1f9c },
-	{ 0x0345, 0x1f9d },
-	{ 0x0345, 0x1f9e },
-	{ 0x0345, 0x1f9f },
-	{ 0x0345, 0x1fa2 },
-	{ 0x0345, 0x1fa3 },
-	{ 0x0345, 0x1fa4 },
-	{ 0x0345, 0x1fa5 },
-	{ 0x0345, 0x1fa6 },
-	{ 0x0345, 0x1fa7 },
-	{ 0x0345, 0x1faa },
-	{ 0x0345, 0x1fab },
-	{ 0x0345, 0x1fac },
-	{ 0x0345, 0x1fad },
-	{ 0x0345, 0x1fae },
-	{ 0x0345, 0x1faf },
-	{ 0x0345, 0x1fb2 },
-	{ 0x0345, 0x1fc2 },
-	{ 0x0345, 0x1ff2 },
-	{ 0x0345, 0x1fb7 },
-	{ 0x0345, 0x1fc7 },
-	{ 0x0345, 0x1ff7 },
-	{ 0x0338, 0x219a },
-	{ 0x0338, 0x219b },
-	{ 0x0338, 0x21ae },
-	{ 0x0338, 0x21cd },
-	{ 0x0338, 0x21cf },
-	{ 0x0338, 0x21ce },
-	{ 0x0338, 0x2204 },
-	{ 0x0338, 0x2209 },
-	{ 0x0338, 0x220c },
-	{ 0x0338, 0x2224 },
-	{ 0x0338, 0x2226 },
-	{ 0x0338, 0x2241 },
-	{ 0x0338, 0x2244 },
-	{ 0x0338, 0x2247 },
-	{ 0x0338, 0x2249 },
-	{ 0x0338, 0x226d },
-	{ 0x0338, 0x2262 },
-	{ 0x0338, 0x2270 },
-	{ 0x0338, 0x2271 },
-	{ 0x0338, 0x2274 },
-	{ 0x0338, 0x2275 },
-	{ 0x0338, 0x2278 },
-	{ 0x0338, 0x2279 },
-	{ 0x0338, 0x2280 },
-	{ 0x0338, 0x2281 },
-	{ 0x0338, 0x22e0 },
-	{ 0x0338, 0x22e1 },
-	{ 0x0338, 0x2284 },
-	{ 0x0338, 0x2285 },
-	{ 0x0338, 0x2288 },
-	{ 0x0338, 0x2289 },
-	{ 0x0338, 0x22e2 },
-	{ 0x0338, 0x22e3 },
-	{ 0x0338, 0x22ac },
-	{ 0x0338, 0x22ad },
-	{ 0x0338, 0x22ae },
-	{ 0x0338, 0x22af },
-	{ 0x0338, 0x22ea },
-	{ 0x0338, 0x22eb },
-	{ 0x0338, 0x22ec },
-	{ 0x0338, 0x22ed },
-	{ 0x3099, 0x3094 },
-	{ 0x3099, 0x304c },
-	{ 0x3099, 0x304e },
-	{ 0x3099, 0x3050 },
-	{ 0x3099, 0x3052 },
-	{ 0x3099, 0x3054 },
-	{ 0x3099, 0x3056 },
-	{ 0x3099, 0x3058 },
-	{ 0x3099, 0x305a },
-	{ 0x3099, 0x305c },
-	{ 0x3099, 0x305e },
-	{ 0x3099, 0x3060 },
-	{ 0x3099, 0x3062 },
-	{ 0x3099, 0x3065 },
-	{ 0x3099, 0x3067 },
-	{ 0x3099, 0x3069 },
-	{ 0x3099, 0x309e },
-	{ 0x3099, 0x30f4 },
-	{ 0x3099, 0x30ac },
-	{ 0x3099, 0x30ae },
-	{ 0x3099, 0x30b0 },
-	{ 0x3099, 0x30b2 },
-	{ 0x3099, 0x30b4 },
-	{ 0x3099, 0x30b6 },
-	{ 0x3099, 0x30b8 },
-	{ 0x3099, 0x30ba },
-	{ 0x3099, 0x30bc },
-	{ 0x3099, 0x30be },
-	{ 0x3099, 0x30c0 },
-	{ 0x3099, 0x30c2 },
-	{ 0x3099, 0x30c5 },
-	{ 0x3099, 0x30c7 },
-	{ 0x3099, 0x30c9 },
-	{ 0x3099, 0x30f7 },
-	{ 0x3099, 0x30f8 },
-	{ 0x3099, 0x30f9 },
-	{ 0x3099, 0x30fa },
-	{ 0x3099, 0x30fe },
-};
+#define COMPOSE_PAIR_KEY(first, second) \
+	(((uint32_t)(first) << 16) | (uint32_t)(second))
+#define COMPOSE_PAIR_BUCKET(key) \
+	((uint32_t)((key) * UINT32_C(0x9e3779b1)) >> \
+	 (32 - COMPOSE_PAIR_BUCKET_BITS))
+#define COMPOSE_PAIR_SLOT(key, displacement) \
+	((uint32_t)(((key) ^ (uint32_t)((displacement) * UINT32_C(0x9e3779b9))) * \
+		    UINT32_C(0x85ebca6b)) >> (32 - COMPOSE_PAIR_SLOT_BITS))
 
 
-static const uint16_t compose_second_single[][2] = {
-	{ 0x0627, 0x0622 },
-	{ 0x0627, 0x0623 },
-	{ 0x0627, 0x0625 },
-	{ 0x09c7, 0x09cb },
-	{ 0x09c7, 0x09cc },
-	{ 0x0b47, 0x0b4b },
-	{ 0x0b47, 0x0b48 },
-	{ 0x0b47, 0x0b4c },
-	{ 0x0bc6, 0x0bca },
-	{ 0x0bc6, 0x0bcc },
-	{ 0x0cc6, 0x0cca },
-	{ 0x0cc6, 0x0cc7 },
-	{ 0x0cc6, 0x0cc8 },
-	{ 0x0d46, 0x0d4a },
-	{ 0x0d46, 0x0d4c },
-	{ 0x0dd9, 0x0dda },
-	{ 0x0dd9, 0x0ddc },
-	{ 0x0dd9, 0x0dde },
+static const uint16_t compose_pair_displacements[1 << COMPOSE_PAIR_BUCKET_BITS] = {
+	    0,     0,     1,     1,     3,     0,     0,     1,
+	    4,     0,     0,     1,     0,     0,     0,     1,
+	    1,     0,     0,     1,     0,     6,     0,     0,
+	    0,     0,     0,     0,     0,     0,     0,     0,
+	    1,     0,     0,     0,     1,     4,     1,     0,
+	    0,     0,     1,     3,     1,     0,     0,     1,
+	    1,     0,     2,     0,     0,     0,     1,     0,
+	    1,     0,     0,     0,     0,     5,     1,     0,
+	    0,     2,     0,     0,     3,     0,     0,     1,
+	    0,     2,     1,     0,     2,     5,     0,     0,
+	    0,     0,     1,     1,     0,     0,     3,     0,
+	    0,     0,     1,     0,     3,     0,     4,     1,
+	    3,     0,     1,     1,     3,     0,     2,     0,
+	    2,     3,     1,     2,     1,     2,     2,     1,
+	    0,     0,     0,     0,     1,     0,     0,     1,
+	    1,     1,     0,     1,     1,     0,     1,     0,
+	    0,     2,     0,     0,     4,     0,     0,     4,
+	    3,     0,     0,     0,     2,     0,     0,     0,
+	    0,     2,     0,     0,     0,     0,     1,     0,
+	    0,     3,     0,     0,     1,     0,     3,     0,
+	    2,     0,     0,     1,     0,     1,     2,     2,
+	    2,     2,     0,     1,     0,     0,     2,     1,
+	    0,     0,     1,     0,     0,     0,     0,     2,
+	    0,     0,     0,     0,     0,     0,     1,     0,
+	    0,     1,     0,     0,     0,     1,     1,     3,
+	    6,     1,     0,     0,     1,     0,     1,     0,
+	    1,     1,     0,     0,     1,     7,     0,     0,
+	    2,     0,     0,     0,     0,     3,     3,     2,
+	    3,     1,     1,     0,     1,     0,     0,     0,
+	    0,     0,     6,     0,     1,     0,     1,     0,
+	    0,     3,     0,     0,     0,     0,     1,     0,
+	    0,     2,     0,     1,     0,     1,     0,     0,
+	    2,     0,     0,     0,     0,     0,     1,     0,
+	    1,     0,     1,     2,     0,     1,     1,     2,
+	    0,     0,     1,     1,     1,     0,     1,     0,
+	    1,     0,     2,     2,     0,     1,     3,     0,
+	    0,     0,     3,     0,     0,     0,     0,     0,
+	    1,     0,     2,     0,     1,     1,     0,     0,
+	    1,     0,     0,     0,     0,     0,     1,     0,
+	    1,     0,     0,     4,     3,     1,     0,     0,
+	    0,     0,     4,     1,     0,     0,     1,     2,
+	    4,     0,     0,     1,     0,     0,     2,     4,
+	    0,     0,     0,     0,     0,     0,     0,     0,
+	    1,     1,     2,     4,     0,     0,     0,     0,
+	    1,     1,     0,     0,     0,     0,     0,     1,
+	    0,     0,     0,     0,     0,     3,     3,     0,
+	    1,     0,     5,     0,     1,     0,     3,     0,
+	    1,     1,     3,     1,     0,     0,     0,     0,
+	    2,     0,     0,     0,     1,     4,     1,     0,
+	    0,     0,     0,     0,     0,     0,     1,     1,
+	    1,     1,     1,     1,     1,     4,     0,     1,
+	    0,     0,     9,     0,     0,     0,     0,     2,
+	    3,     0,     1,     1,     3,     3,     1,     3,
+	    2,     0,     3,     2,     0,     3,     4,     0,
+	    0,     7,     0,     2,     0,     0,     2,     1,
+	    0,     0,     2,     0,     0,     0,     3,     1,
+	    2,     0,     6,     0,     0,     1,     3,     0,
+	    0,     0,     1,     0,     0,     3,     7,     0,
+	    3,     3,     4,     0,     2,     0,     0,     1,
+	    0,     1,     1,     0,     0,     5,     3,     0,
+	    2,     0,     1,     6,     0,     1,     1,     0,
+	    0,     0,     3,     0,     0,     1,     1,     3,
+	    0,     0,     1,     3,     3,     0,     7,     0,
+	    0,     0,     0,     0,     3,     0,     0,     0,
 };
 
 
-static const uint16_t compose_array[146][31] = {
-	{
-		0x00c0, 0x00c1, 0x00c2, 0x00c3, 0x0100, 0x0102, 0x0226, 
-		0x00c4, 0x1ea2, 0x00c5,      0, 0x01cd, 0x0200, 0x0202, 
-		     0,      0,      0, 0x1ea0,      0, 0x1e00,      0, 
-		     0, 0x0104,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0, 0x1e02, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1e04,      0,      0,      0, 
-		     0,      0,      0,      0,      0, 0x1e06,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x0106, 0x0108,      0,      0,      0, 0x010a, 
-		     0,      0,      0,      0, 0x010c,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x00c7,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0, 0x1e0a, 
-		     0,      0,      0,      0, 0x010e,      0,      0, 
-		     0,      0,      0, 0x1e0c,      0,      0,      0, 
-		0x1e10,      0, 0x1e12,      0,      0, 0x1e0e,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x00c8, 0x00c9, 0x00ca, 0x1ebc, 0x0112, 0x0114, 0x0116, 
-		0x00cb, 0x1eba,      0,      0, 0x011a, 0x0204, 0x0206, 
-		     0,      0,      0, 0x1eb8,      0,      0,      0, 
-		0x0228, 0x0118, 0x1e18,      0, 0x1e1a,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x01f4, 0x011c,      0, 0x1e20, 0x011e, 0x0120, 
-		     0,      0,      0,      0, 0x01e6,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x0122,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0, 0x0124,      0,      0,      0, 0x1e22, 
-		0x1e26,      0,      0,      0, 0x021e,      0,      0, 
-		     0,      0,      0, 0x1e24,      0,      0,      0, 
-		0x1e28,      0,      0, 0x1e2a,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x00cc, 0x00cd, 0x00ce, 0x0128, 0x012a, 0x012c, 0x0130, 
-		0x00cf, 0x1ec8,      0,      0, 0x01cf, 0x0208, 0x020a, 
-		     0,      0,      0, 0x1eca,      0,      0,      0, 
-		     0, 0x012e,      0,      0, 0x1e2c,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x1e30,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0, 0x01e8,      0,      0, 
-		     0,      0,      0, 0x1e32,      0,      0,      0, 
-		0x0136,      0,      0,      0,      0, 0x1e34,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x0139,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0, 0x013d,      0,      0, 
-		     0,      0,      0, 0x1e36,      0,      0,      0, 
-		0x013b,      0, 0x1e3c,      0,      0, 0x1e3a,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x1e3e,      0,      0,      0,      0, 0x1e40, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1e42,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x01f8, 0x0143,      0, 0x00d1,      0,      0, 0x1e44, 
-		     0,      0,      0,      0, 0x0147,      0,      0, 
-		     0,      0,      0, 0x1e46,      0,      0,      0, 
-		0x0145,      0, 0x1e4a,      0,      0, 0x1e48,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x00d2, 0x00d3, 0x00d4, 0x00d5, 0x014c, 0x014e, 0x022e, 
-		0x00d6, 0x1ece,      0, 0x0150, 0x01d1, 0x020c, 0x020e, 
-		     0,      0, 0x01a0, 0x1ecc,      0,      0,      0, 
-		     0, 0x01ea,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x1e54,      0,      0,      0,      0, 0x1e56, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x0154,      0,      0,      0,      0, 0x1e58, 
-		     0,      0,      0,      0, 0x0158, 0x0210, 0x0212, 
-		     0,      0,      0, 0x1e5a,      0,      0,      0, 
-		0x0156,      0,      0,      0,      0, 0x1e5e,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x015a, 0x015c,      0,      0,      0, 0x1e60, 
-		     0,      0,      0,      0, 0x0160,      0,      0, 
-		     0,      0,      0, 0x1e62,      0,      0, 0x0218, 
-		0x015e,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0, 0x1e6a, 
-		     0,      0,      0,      0, 0x0164,      0,      0, 
-		     0,      0,      0, 0x1e6c,      0,      0, 0x021a, 
-		0x0162,      0, 0x1e70,      0,      0, 0x1e6e,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x00d9, 0x00da, 0x00db, 0x0168, 0x016a, 0x016c,      0, 
-		0x00dc, 0x1ee6, 0x016e, 0x0170, 0x01d3, 0x0214, 0x0216, 
-		     0,      0, 0x01af, 0x1ee4, 0x1e72,      0,      0, 
-		     0, 0x0172, 0x1e76,      0, 0x1e74,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0, 0x1e7c,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1e7e,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1e80, 0x1e82, 0x0174,      0,      0,      0, 0x1e86, 
-		0x1e84,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1e88,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0, 0x1e8a, 
-		0x1e8c,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1ef2, 0x00dd, 0x0176, 0x1ef8, 0x0232,      0, 0x1e8e, 
-		0x0178, 0x1ef6,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1ef4,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x0179, 0x1e90,      0,      0,      0, 0x017b, 
-		     0,      0,      0,      0, 0x017d,      0,      0, 
-		     0,      0,      0, 0x1e92,      0,      0,      0, 
-		     0,      0,      0,      0,      0, 0x1e94,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x0101, 0x0103, 0x0227, 
-		0x00e4, 0x1ea3, 0x00e5,      0, 0x01ce, 0x0201, 0x0203, 
-		     0,      0,      0, 0x1ea1,      0, 0x1e01,      0, 
-		     0, 0x0105,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0, 0x1e03, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1e05,      0,      0,      0, 
-		     0,      0,      0,      0,      0, 0x1e07,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x0107, 0x0109,      0,      0,      0, 0x010b, 
-		     0,      0,      0,      0, 0x010d,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x00e7,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0, 0x1e0b, 
-		     0,      0,      0,      0, 0x010f,      0,      0, 
-		     0,      0,      0, 0x1e0d,      0,      0,      0, 
-		0x1e11,      0, 0x1e13,      0,      0, 0x1e0f,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x00e8, 0x00e9, 0x00ea, 0x1ebd, 0x0113, 0x0115, 0x0117, 
-		0x00eb, 0x1ebb,      0,      0, 0x011b, 0x0205, 0x0207, 
-		     0,      0,      0, 0x1eb9,      0,      0,      0, 
-		0x0229, 0x0119, 0x1e19,      0, 0x1e1b,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x01f5, 0x011d,      0, 0x1e21, 0x011f, 0x0121, 
-		     0,      0,      0,      0, 0x01e7,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x0123,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0, 0x0125,      0,      0,      0, 0x1e23, 
-		0x1e27,      0,      0,      0, 0x021f,      0,      0, 
-		     0,      0,      0, 0x1e25,      0,      0,      0, 
-		0x1e29,      0,      0, 0x1e2b,      0, 0x1e96,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x00ec, 0x00ed, 0x00ee, 0x0129, 0x012b, 0x012d,      0, 
-		0x00ef, 0x1ec9,      0,      0, 0x01d0, 0x0209, 0x020b, 
-		     0,      0,      0, 0x1ecb,      0,      0,      0, 
-		     0, 0x012f,      0,      0, 0x1e2d,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0, 0x0135,      0,      0,      0,      0, 
-		     0,      0,      0,      0, 0x01f0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x1e31,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0, 0x01e9,      0,      0, 
-		     0,      0,      0, 0x1e33,      0,      0,      0, 
-		0x0137,      0,      0,      0,      0, 0x1e35,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x013a,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0, 0x013e,      0,      0, 
-		     0,      0,      0, 0x1e37,      0,      0,      0, 
-		0x013c,      0, 0x1e3d,      0,      0, 0x1e3b,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x1e3f,      0,      0,      0,      0, 0x1e41, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1e43,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x01f9, 0x0144,      0, 0x00f1,      0,      0, 0x1e45, 
-		     0,      0,      0,      0, 0x0148,      0,      0, 
-		     0,      0,      0, 0x1e47,      0,      0,      0, 
-		0x0146,      0, 0x1e4b,      0,      0, 0x1e49,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x014d, 0x014f, 0x022f, 
-		0x00f6, 0x1ecf,      0, 0x0151, 0x01d2, 0x020d, 0x020f, 
-		     0,      0, 0x01a1, 0x1ecd,      0,      0,      0, 
-		     0, 0x01eb,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x1e55,      0,      0,      0,      0, 0x1e57, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x0155,      0,      0,      0,      0, 0x1e59, 
-		     0,      0,      0,      0, 0x0159, 0x0211, 0x0213, 
-		     0,      0,      0, 0x1e5b,      0,      0,      0, 
-		0x0157,      0,      0,      0,      0, 0x1e5f,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x015b, 0x015d,      0,      0,      0, 0x1e61, 
-		     0,      0,      0,      0, 0x0161,      0,      0, 
-		     0,      0,      0, 0x1e63,      0,      0, 0x0219, 
-		0x015f,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0, 0x1e6b, 
-		0x1e97,      0,      0,      0, 0x0165,      0,      0, 
-		     0,      0,      0, 0x1e6d,      0,      0, 0x021b, 
-		0x0163,      0, 0x1e71,      0,      0, 0x1e6f,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x00f9, 0x00fa, 0x00fb, 0x0169, 0x016b, 0x016d,      0, 
-		0x00fc, 0x1ee7, 0x016f, 0x0171, 0x01d4, 0x0215, 0x0217, 
-		     0,      0, 0x01b0, 0x1ee5, 0x1e73,      0,      0, 
-		     0, 0x0173, 0x1e77,      0, 0x1e75,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0, 0x1e7d,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1e7f,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1e81, 0x1e83, 0x0175,      0,      0,      0, 0x1e87, 
-		0x1e85,      0, 0x1e98,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1e89,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0, 0x1e8b, 
-		0x1e8d,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1ef3, 0x00fd, 0x0177, 0x1ef9, 0x0233,      0, 0x1e8f, 
-		0x00ff, 0x1ef7, 0x1e99,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1ef5,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x017a, 0x1e91,      0,      0,      0, 0x017c, 
-		     0,      0,      0,      0, 0x017e,      0,      0, 
-		     0,      0,      0, 0x1e93,      0,      0,      0, 
-		     0,      0,      0,      0,      0, 0x1e95,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1fed, 0x0385,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1fc1, 
-		     0,      0,      0, 
-	},
-	{
-		0x1ea6, 0x1ea4,      0, 0x1eaa,      0,      0,      0, 
-		     0, 0x1ea8,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x01fc,      0,      0, 0x01e2,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1ec0, 0x1ebe,      0, 0x1ec4,      0,      0,      0, 
-		     0, 0x1ec2,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1ed2, 0x1ed0,      0, 0x1ed6,      0,      0,      0, 
-		     0, 0x1ed4,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x1e4c,      0,      0, 0x022c,      0,      0, 
-		0x1e4e,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x01db, 0x01d7,      0,      0, 0x01d5,      0,      0, 
-		     0,      0,      0,      0, 0x01d9,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1ea7, 0x1ea5,      0, 0x1eab,      0,      0,      0, 
-		     0, 0x1ea9,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x01fd,      0,      0, 0x01e3,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1ec1, 0x1ebf,      0, 0x1ec5,      0,      0,      0, 
-		     0, 0x1ec3,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1ed3, 0x1ed1,      0, 0x1ed7,      0,      0,      0, 
-		     0, 0x1ed5,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x1e4d,      0,      0, 0x022d,      0,      0, 
-		0x1e4f,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x01dc, 0x01d8,      0,      0, 0x01d6,      0,      0, 
-		     0,      0,      0,      0, 0x01da,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1eb0, 0x1eae,      0, 0x1eb4,      0,      0,      0, 
-		     0, 0x1eb2,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1eb1, 0x1eaf,      0, 0x1eb5,      0,      0,      0, 
-		     0, 0x1eb3,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1e14, 0x1e16,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1e15, 0x1e17,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1e50, 0x1e52,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1e51, 0x1e53,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1edc, 0x1eda,      0, 0x1ee0,      0,      0,      0, 
-		     0, 0x1ede,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1ee2,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1edd, 0x1edb,      0, 0x1ee1,      0,      0,      0, 
-		     0, 0x1edf,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1ee3,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1eea, 0x1ee8,      0, 0x1eee,      0,      0,      0, 
-		     0, 0x1eec,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1ef0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1eeb, 0x1ee9,      0, 0x1eef,      0,      0,      0, 
-		     0, 0x1eed,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 0x1ef1,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1fba, 0x0386,      0,      0, 0x1fb9, 0x1fb8,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1f08, 0x1f09,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1fbc,      0,      0, 
-	},
-	{
-		0x1fc8, 0x0388,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1f18, 0x1f19,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1fca, 0x0389,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1f28, 0x1f29,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1fcc,      0,      0, 
-	},
-	{
-		0x1fda, 0x038a,      0,      0, 0x1fd9, 0x1fd8,      0, 
-		0x03aa,      0,      0,      0,      0,      0,      0, 
-		0x1f38, 0x1f39,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1ff8, 0x038c,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1f48, 0x1f49,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1fea, 0x038e,      0,      0, 0x1fe9, 0x1fe8,      0, 
-		0x03ab,      0,      0,      0,      0,      0,      0, 
-		     0, 0x1f59,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1ffa, 0x038f,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1f68, 0x1f69,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1ffc,      0,      0, 
-	},
-	{
-		0x1f70, 0x03ac,      0,      0, 0x1fb1, 0x1fb0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1f00, 0x1f01,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1fb6, 
-		0x1fb3,      0,      0, 
-	},
-	{
-		0x1f72, 0x03ad,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1f10, 0x1f11,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f74, 0x03ae,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1f20, 0x1f21,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1fc6, 
-		0x1fc3,      0,      0, 
-	},
-	{
-		0x1f76, 0x03af,      0,      0, 0x1fd1, 0x1fd0,      0, 
-		0x03ca,      0,      0,      0,      0,      0,      0, 
-		0x1f30, 0x1f31,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1fd6, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f78, 0x03cc,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1f40, 0x1f41,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1fe4, 0x1fe5,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f7a, 0x03cd,      0,      0, 0x1fe1, 0x1fe0,      0, 
-		0x03cb,      0,      0,      0,      0,      0,      0, 
-		0x1f50, 0x1f51,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1fe6, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f7c, 0x03ce,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		0x1f60, 0x1f61,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1ff6, 
-		0x1ff3,      0,      0, 
-	},
-	{
-		0x1fd2, 0x0390,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1fd7, 
-		     0,      0,      0, 
-	},
-	{
-		0x1fe2, 0x03b0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1fe7, 
-		     0,      0,      0, 
-	},
-	{
-		     0, 0x03d3,      0,      0,      0,      0,      0, 
-		0x03d4,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0, 0x04d0,      0, 
-		0x04d2,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x0400,      0,      0,      0,      0, 0x04d6,      0, 
-		0x0401,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0, 0x04c1,      0, 
-		0x04dc,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x040d,      0,      0,      0, 0x04e2, 0x0419,      0, 
-		0x04e4,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0, 0x04ee, 0x040e,      0, 
-		0x04f0,      0,      0, 0x04f2,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0, 0x04d1,      0, 
-		0x04d3,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x0450,      0,      0,      0,      0, 0x04d7,      0, 
-		0x0451,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0, 0x04c2,      0, 
-		0x04dd,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x045d,      0,      0,      0, 0x04e3, 0x0439,      0, 
-		0x04e5,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0, 0x04ef, 0x045e,      0, 
-		0x04f1,      0,      0, 0x04f3,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0, 0x1eac,      0,      0, 0x1eb6,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0, 0x1ead,      0,      0, 0x1eb7,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f02, 0x1f04,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f06, 
-		0x1f80,      0,      0, 
-	},
-	{
-		0x1f03, 0x1f05,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f07, 
-		0x1f81,      0,      0, 
-	},
-	{
-		0x1f0a, 0x1f0c,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f0e, 
-		0x1f88,      0,      0, 
-	},
-	{
-		0x1f0b, 0x1f0d,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f0f, 
-		0x1f89,      0,      0, 
-	},
-	{
-		0x1f12, 0x1f14,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f13, 0x1f15,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f1a, 0x1f1c,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f1b, 0x1f1d,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f22, 0x1f24,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f26, 
-		0x1f90,      0,      0, 
-	},
-	{
-		0x1f23, 0x1f25,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f27, 
-		0x1f91,      0,      0, 
-	},
-	{
-		0x1f2a, 0x1f2c,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f2e, 
-		0x1f98,      0,      0, 
-	},
-	{
-		0x1f2b, 0x1f2d,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f2f, 
-		0x1f99,      0,      0, 
-	},
-	{
-		0x1f32, 0x1f34,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f36, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f33, 0x1f35,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f37, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f3a, 0x1f3c,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f3e, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f3b, 0x1f3d,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f3f, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f42, 0x1f44,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f43, 0x1f45,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f4a, 0x1f4c,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f4b, 0x1f4d,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f52, 0x1f54,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f56, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f53, 0x1f55,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f57, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f5b, 0x1f5d,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f5f, 
-		     0,      0,      0, 
-	},
-	{
-		0x1f62, 0x1f64,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f66, 
-		0x1fa0,      0,      0, 
-	},
-	{
-		0x1f63, 0x1f65,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f67, 
-		0x1fa1,      0,      0, 
-	},
-	{
-		0x1f6a, 0x1f6c,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f6e, 
-		0x1fa8,      0,      0, 
-	},
-	{
-		0x1f6b, 0x1f6d,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1f6f, 
-		0x1fa9,      0,      0, 
-	},
-	{
-		0x1fcd, 0x1fce,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1fcf, 
-		     0,      0,      0, 
-	},
-	{
-		0x1fdd, 0x1fde,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0, 0x1fdf, 
-		     0,      0,      0, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0, 0x3070, 0x3071, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0, 0x3073, 0x3074, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0, 0x3076, 0x3077, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0, 0x3079, 0x307a, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0, 0x307c, 0x307d, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0, 0x30d0, 0x30d1, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0, 0x30d3, 0x30d4, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0, 0x30d6, 0x30d7, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0, 0x30d9, 0x30da, 
-	},
-	{
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0,      0,      0,      0,      0,      0,      0, 
-		     0, 0x30dc, 0x30dd, 
-	},
+static const uint16_t compose_pairs[1 << COMPOSE_PAIR_SLOT_BITS][3] = {
+	{ 0, 0, 0 },
+	{ 0x006b, 0x0331, 0x1e35 },
+	{ 0, 0, 0 },
+	{ 0x1f6d, 0x0345, 0x1fad },
+	{ 0x0052, 0x0327, 0x0156 },
+	{ 0x0048, 0x0323, 0x1e24 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0049, 0x0330, 0x1e2c },
+	{ 0x03a5, 0x0301, 0x038e },
+	{ 0x015a, 0x0307, 0x1e64 },
+	{ 0x0058, 0x0307, 0x1e8a },
+	{ 0x00ca, 0x0301, 0x1ebe },
+	{ 0x0049, 0x0301, 0x00cd },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30b7, 0x3099, 0x30b8 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f19, 0x0301, 0x1f1d },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0041, 0x0303, 0x00c3 },
+	{ 0, 0, 0 },
+	{ 0x22b2, 0x0338, 0x22ea },
+	{ 0x2287, 0x0338, 0x2289 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x006c, 0x0327, 0x013c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x006e, 0x030c, 0x0148 },
+	{ 0, 0, 0 },
+	{ 0x0055, 0x0302, 0x00db },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f20, 0x0300, 0x1f22 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0074, 0x032d, 0x1e71 },
+	{ 0x1f2a, 0x0345, 0x1f9a },
+	{ 0x0065, 0x0327, 0x0229 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0456, 0x0308, 0x0457 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0075, 0x030b, 0x0171 },
+	{ 0x0045, 0x0309, 0x1eba },
+	{ 0x0061, 0x0303, 0x00e3 },
+	{ 0, 0, 0 },
+	{ 0x1f00, 0x0301, 0x1f04 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00f5, 0x0301, 0x1e4d },
+	{ 0x01b0, 0x0309, 0x1eed },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0102, 0x0303, 0x1eb4 },
+	{ 0x2277, 0x0338, 0x2279 },
+	{ 0x006e, 0x0301, 0x0144 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0074, 0x0327, 0x0163 },
+	{ 0x0053, 0x0323, 0x1e62 },
+	{ 0x0415, 0x0300, 0x0400 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0047, 0x0306, 0x011e },
+	{ 0x0054, 0x0331, 0x1e6e },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0079, 0x0304, 0x0233 },
+	{ 0, 0, 0 },
+	{ 0x22b3, 0x0338, 0x22eb },
+	{ 0x1f68, 0x0345, 0x1fa8 },
+	{ 0x006e, 0x0323, 0x1e47 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0443, 0x0308, 0x04f1 },
+	{ 0, 0, 0 },
+	{ 0x0041, 0x0311, 0x0202 },
+	{ 0x30f0, 0x3099, 0x30f8 },
+	{ 0x0cc6, 0x0cd5, 0x0cc7 },
+	{ 0x0053, 0x0307, 0x1e60 },
+	{ 0x00c5, 0x0301, 0x01fa },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03cb, 0x0342, 0x1fe7 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00d8, 0x0301, 0x01fe },
+	{ 0x0072, 0x0301, 0x0155 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0070, 0x0307, 0x1e57 },
+	{ 0x0077, 0x0301, 0x1e83 },
+	{ 0x2282, 0x0338, 0x2284 },
+	{ 0x0054, 0x0326, 0x021a },
+	{ 0, 0, 0 },
+	{ 0x04e8, 0x0308, 0x04ea },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0074, 0x0323, 0x1e6d },
+	{ 0x0069, 0x030c, 0x01d0 },
+	{ 0, 0, 0 },
+	{ 0x00d6, 0x0304, 0x022a },
+	{ 0, 0, 0 },
+	{ 0x1f61, 0x0300, 0x1f63 },
+	{ 0x03b1, 0x0345, 0x1fb3 },
+	{ 0x0928, 0x093c, 0x0929 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004a, 0x0302, 0x0134 },
+	{ 0x004e, 0x0331, 0x1e48 },
+	{ 0x0074, 0x030c, 0x0165 },
+	{ 0, 0, 0 },
+	{ 0x1f25, 0x0345, 0x1f95 },
+	{ 0x03b5, 0x0313, 0x1f10 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0406, 0x0308, 0x0407 },
+	{ 0, 0, 0 },
+	{ 0x004f, 0x030f, 0x020c },
+	{ 0x30b3, 0x3099, 0x30b4 },
+	{ 0x01af, 0x0301, 0x1ee8 },
+	{ 0, 0, 0 },
+	{ 0x0057, 0x0301, 0x1e82 },
+	{ 0x1fbf, 0x0301, 0x1fce },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0069, 0x0301, 0x00ed },
+	{ 0x306f, 0x3099, 0x3070 },
+	{ 0x1f24, 0x0345, 0x1f94 },
+	{ 0x0103, 0x0309, 0x1eb3 },
+	{ 0x1f00, 0x0342, 0x1f06 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0055, 0x0330, 0x1e74 },
+	{ 0x039f, 0x0301, 0x038c },
+	{ 0x1ffe, 0x0342, 0x1fdf },
+	{ 0x0041, 0x0328, 0x0104 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004c, 0x032d, 0x1e3c },
+	{ 0x0077, 0x030a, 0x1e98 },
+	{ 0, 0, 0 },
+	{ 0x0063, 0x0302, 0x0109 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1e36, 0x0304, 0x1e38 },
+	{ 0, 0, 0 },
+	{ 0x0057, 0x0300, 0x1e80 },
+	{ 0x0061, 0x030c, 0x01ce },
+	{ 0, 0, 0 },
+	{ 0x0073, 0x0327, 0x015f },
+	{ 0x0048, 0x0327, 0x1e28 },
+	{ 0, 0, 0 },
+	{ 0x0435, 0x0300, 0x0450 },
+	{ 0x0055, 0x031b, 0x01af },
+	{ 0x2248, 0x0338, 0x2249 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00d4, 0x0309, 0x1ed4 },
+	{ 0x004e, 0x0307, 0x1e44 },
+	{ 0x006f, 0x0303, 0x00f5 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x3057, 0x3099, 0x3058 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0041, 0x0307, 0x0226 },
+	{ 0, 0, 0 },
+	{ 0x1f08, 0x0345, 0x1f88 },
+	{ 0x22a8, 0x0338, 0x22ad },
+	{ 0, 0, 0 },
+	{ 0x03a9, 0x0314, 0x1f69 },
+	{ 0, 0, 0 },
+	{ 0x0437, 0x0308, 0x04df },
+	{ 0, 0, 0 },
+	{ 0x03b1, 0x0306, 0x1fb0 },
+	{ 0, 0, 0 },
+	{ 0x0064, 0x030c, 0x010f },
+	{ 0, 0, 0 },
+	{ 0x00fc, 0x0304, 0x01d6 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03ac, 0x0345, 0x1fb4 },
+	{ 0x0cc6, 0x0cc2, 0x0cca },
+	{ 0, 0, 0 },
+	{ 0x004f, 0x0302, 0x00d4 },
+	{ 0, 0, 0 },
+	{ 0x1fb6, 0x0345, 0x1fb7 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03c1, 0x0314, 0x1fe5 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0068, 0x0308, 0x1e27 },
+	{ 0x1f20, 0x0345, 0x1f90 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004f, 0x0311, 0x020e },
+	{ 0x309d, 0x3099, 0x309e },
+	{ 0x01af, 0x0303, 0x1eee },
+	{ 0x0103, 0x0303, 0x1eb5 },
+	{ 0x0061, 0x0311, 0x0203 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0399, 0x0313, 0x1f38 },
+	{ 0, 0, 0 },
+	{ 0x00e2, 0x0303, 0x1eab },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f30, 0x0342, 0x1f36 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00e7, 0x0301, 0x1e09 },
+	{ 0, 0, 0 },
+	{ 0x01a0, 0x0301, 0x1eda },
+	{ 0, 0, 0 },
+	{ 0x0391, 0x0314, 0x1f09 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0053, 0x0327, 0x015e },
+	{ 0x006d, 0x0323, 0x1e43 },
+	{ 0x03b5, 0x0300, 0x1f72 },
+	{ 0, 0, 0 },
+	{ 0x00e4, 0x0304, 0x01df },
+	{ 0, 0, 0 },
+	{ 0x0059, 0x0300, 0x1ef2 },
+	{ 0x1e5b, 0x0304, 0x1e5d },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0292, 0x030c, 0x01ef },
+	{ 0, 0, 0 },
+	{ 0x1f09, 0x0345, 0x1f89 },
+	{ 0x1f29, 0x0300, 0x1f2b },
+	{ 0, 0, 0 },
+	{ 0x0057, 0x0302, 0x0174 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0045, 0x0308, 0x00cb },
+	{ 0x0043, 0x0327, 0x00c7 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004f, 0x0328, 0x01ea },
+	{ 0x0074, 0x0307, 0x1e6b },
+	{ 0x00e6, 0x0301, 0x01fd },
+	{ 0x0065, 0x0301, 0x00e9 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0044, 0x0307, 0x1e0a },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x006f, 0x0309, 0x1ecf },
+	{ 0x1f60, 0x0301, 0x1f64 },
+	{ 0x017f, 0x0307, 0x1e9b },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0055, 0x0301, 0x00da },
+	{ 0, 0, 0 },
+	{ 0x224d, 0x0338, 0x226d },
+	{ 0x1f60, 0x0342, 0x1f66 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x005a, 0x0323, 0x1e92 },
+	{ 0x01b7, 0x030c, 0x01ee },
+	{ 0x0229, 0x0306, 0x1e1d },
+	{ 0, 0, 0 },
+	{ 0x0055, 0x0308, 0x00dc },
+	{ 0x00c2, 0x0300, 0x1ea6 },
+	{ 0x1b0d, 0x1b35, 0x1b0e },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f11, 0x0300, 0x1f13 },
+	{ 0x007a, 0x0302, 0x1e91 },
+	{ 0x004f, 0x0304, 0x014c },
+	{ 0x0c46, 0x0c56, 0x0c48 },
+	{ 0x0053, 0x030c, 0x0160 },
+	{ 0x0065, 0x032d, 0x1e19 },
+	{ 0, 0, 0 },
+	{ 0x0077, 0x0323, 0x1e89 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0410, 0x0308, 0x04d2 },
+	{ 0x0075, 0x0311, 0x0217 },
+	{ 0x00e2, 0x0309, 0x1ea9 },
+	{ 0x0061, 0x0309, 0x1ea3 },
+	{ 0, 0, 0 },
+	{ 0x004d, 0x0301, 0x1e3e },
+	{ 0x1f49, 0x0301, 0x1f4d },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30bb, 0x3099, 0x30bc },
+	{ 0x03cb, 0x0301, 0x03b0 },
+	{ 0, 0, 0 },
+	{ 0x1f19, 0x0300, 0x1f1b },
+	{ 0x0055, 0x030f, 0x0214 },
+	{ 0, 0, 0 },
+	{ 0x0049, 0x0307, 0x0130 },
+	{ 0x0072, 0x030f, 0x0211 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0391, 0x0313, 0x1f08 },
+	{ 0, 0, 0 },
+	{ 0x0399, 0x0308, 0x03aa },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0072, 0x030c, 0x0159 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f68, 0x0300, 0x1f6a },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x3046, 0x3099, 0x3094 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0061, 0x0300, 0x00e0 },
+	{ 0, 0, 0 },
+	{ 0x0075, 0x0308, 0x00fc },
+	{ 0x1f03, 0x0345, 0x1f83 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0391, 0x0301, 0x0386 },
+	{ 0, 0, 0 },
+	{ 0x0049, 0x0309, 0x1ec8 },
+	{ 0x0065, 0x0303, 0x1ebd },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x3078, 0x3099, 0x3079 },
+	{ 0, 0, 0 },
+	{ 0x1f30, 0x0301, 0x1f34 },
+	{ 0x1f01, 0x0300, 0x1f03 },
+	{ 0, 0, 0 },
+	{ 0x0103, 0x0301, 0x1eaf },
+	{ 0, 0, 0 },
+	{ 0x03b1, 0x0301, 0x03ac },
+	{ 0x0075, 0x0328, 0x0173 },
+	{ 0x1f27, 0x0345, 0x1f97 },
+	{ 0x039f, 0x0314, 0x1f49 },
+	{ 0x03b9, 0x0313, 0x1f30 },
+	{ 0, 0, 0 },
+	{ 0x0423, 0x0304, 0x04ee },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x005a, 0x030c, 0x017d },
+	{ 0x03c9, 0x0345, 0x1ff3 },
+	{ 0x0113, 0x0300, 0x1e15 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0075, 0x0330, 0x1e75 },
+	{ 0x0065, 0x0304, 0x0113 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x3055, 0x3099, 0x3056 },
+	{ 0, 0, 0 },
+	{ 0x01a1, 0x0300, 0x1edd },
+	{ 0x0059, 0x0302, 0x0176 },
+	{ 0, 0, 0 },
+	{ 0x022e, 0x0304, 0x0230 },
+	{ 0x1f6c, 0x0345, 0x1fac },
+	{ 0, 0, 0 },
+	{ 0x1f59, 0x0342, 0x1f5f },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0415, 0x0308, 0x0401 },
+	{ 0x0045, 0x0311, 0x0206 },
+	{ 0, 0, 0 },
+	{ 0x0cca, 0x0cd5, 0x0ccb },
+	{ 0x0057, 0x0307, 0x1e86 },
+	{ 0x00f4, 0x0301, 0x1ed1 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0161, 0x0307, 0x1e67 },
+	{ 0, 0, 0 },
+	{ 0x006f, 0x030b, 0x0151 },
+	{ 0x1f01, 0x0345, 0x1f81 },
+	{ 0x00ea, 0x0309, 0x1ec3 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0410, 0x0306, 0x04d0 },
+	{ 0x004c, 0x0323, 0x1e36 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0059, 0x0304, 0x0232 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x304d, 0x3099, 0x304e },
+	{ 0, 0, 0 },
+	{ 0x00ca, 0x0300, 0x1ec0 },
+	{ 0, 0, 0 },
+	{ 0x0052, 0x0331, 0x1e5e },
+	{ 0x0075, 0x030a, 0x016f },
+	{ 0x0064, 0x0327, 0x1e11 },
+	{ 0x0435, 0x0308, 0x0451 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03b7, 0x0301, 0x03ae },
+	{ 0, 0, 0 },
+	{ 0x30bf, 0x3099, 0x30c0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f01, 0x0301, 0x1f05 },
+	{ 0x03b7, 0x0342, 0x1fc6 },
+	{ 0, 0, 0 },
+	{ 0x3061, 0x3099, 0x3062 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f51, 0x0342, 0x1f57 },
+	{ 0x00f4, 0x0309, 0x1ed5 },
+	{ 0x0050, 0x0307, 0x1e56 },
+	{ 0x006f, 0x0301, 0x00f3 },
+	{ 0, 0, 0 },
+	{ 0x0072, 0x0323, 0x1e5b },
+	{ 0x0045, 0x0328, 0x0118 },
+	{ 0x03c5, 0x0314, 0x1f51 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03d2, 0x0308, 0x03d4 },
+	{ 0x0054, 0x0323, 0x1e6c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0041, 0x0304, 0x0100 },
+	{ 0x0067, 0x0302, 0x011d },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0079, 0x0300, 0x1ef3 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f59, 0x0301, 0x1f5d },
+	{ 0x0d46, 0x0d3e, 0x0d4a },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0ddc, 0x0dca, 0x0ddd },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x042d, 0x0308, 0x04ec },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03ca, 0x0301, 0x0390 },
+	{ 0x01af, 0x0309, 0x1eec },
+	{ 0x0061, 0x0328, 0x0105 },
+	{ 0x0052, 0x0307, 0x1e58 },
+	{ 0x00ef, 0x0301, 0x1e2f },
+	{ 0x0043, 0x0301, 0x0106 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30b1, 0x3099, 0x30b2 },
+	{ 0x305b, 0x3099, 0x305c },
+	{ 0, 0, 0 },
+	{ 0x1f69, 0x0301, 0x1f6d },
+	{ 0, 0, 0 },
+	{ 0x004d, 0x0307, 0x1e40 },
+	{ 0x2265, 0x0338, 0x2271 },
+	{ 0x0d46, 0x0d57, 0x0d4c },
+	{ 0, 0, 0 },
+	{ 0x1fbf, 0x0342, 0x1fcf },
+	{ 0x0053, 0x0326, 0x0218 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0436, 0x0306, 0x04c2 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0068, 0x030c, 0x021f },
+	{ 0x00d5, 0x0304, 0x022c },
+	{ 0x014c, 0x0300, 0x1e50 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0dd9, 0x0dcf, 0x0ddc },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0055, 0x0323, 0x1ee4 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0433, 0x0301, 0x0453 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0065, 0x0307, 0x0117 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1025, 0x102e, 0x1026 },
+	{ 0x30c4, 0x3099, 0x30c5 },
+	{ 0, 0, 0 },
+	{ 0x00c2, 0x0309, 0x1ea8 },
+	{ 0x1f01, 0x0342, 0x1f07 },
+	{ 0x005a, 0x0331, 0x1e94 },
+	{ 0x003d, 0x0338, 0x2260 },
+	{ 0x00c2, 0x0301, 0x1ea4 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x2192, 0x0338, 0x219b },
+	{ 0x0395, 0x0314, 0x1f19 },
+	{ 0, 0, 0 },
+	{ 0x0423, 0x0308, 0x04f0 },
+	{ 0, 0, 0 },
+	{ 0x0069, 0x0323, 0x1ecb },
+	{ 0x03b9, 0x0300, 0x1f76 },
+	{ 0x01ea, 0x0304, 0x01ec },
+	{ 0, 0, 0 },
+	{ 0x0041, 0x0306, 0x0102 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1ea1, 0x0302, 0x1ead },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0b47, 0x0b3e, 0x0b4b },
+	{ 0, 0, 0 },
+	{ 0x03bf, 0x0300, 0x1f78 },
+	{ 0, 0, 0 },
+	{ 0x0047, 0x0327, 0x0122 },
+	{ 0x0068, 0x0323, 0x1e25 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x04d8, 0x0308, 0x04da },
+	{ 0, 0, 0 },
+	{ 0x03c5, 0x0301, 0x03cd },
+	{ 0, 0, 0 },
+	{ 0x0078, 0x0307, 0x1e8b },
+	{ 0x006e, 0x0303, 0x00f1 },
+	{ 0x0061, 0x0323, 0x1ea1 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03c5, 0x0342, 0x1fe6 },
+	{ 0, 0, 0 },
+	{ 0x00c6, 0x0301, 0x01fc },
+	{ 0, 0, 0 },
+	{ 0x1f39, 0x0301, 0x1f3d },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0067, 0x0327, 0x0123 },
+	{ 0x227c, 0x0338, 0x22e0 },
+	{ 0x1f39, 0x0342, 0x1f3f },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0436, 0x0308, 0x04dd },
+	{ 0x0041, 0x0325, 0x1e00 },
+	{ 0, 0, 0 },
+	{ 0x007a, 0x0323, 0x1e93 },
+	{ 0x0063, 0x030c, 0x010d },
+	{ 0, 0, 0 },
+	{ 0x0075, 0x0302, 0x00fb },
+	{ 0x0045, 0x0300, 0x00c8 },
+	{ 0x1b11, 0x1b35, 0x1b12 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x307b, 0x3099, 0x307c },
+	{ 0x064a, 0x0654, 0x0626 },
+	{ 0x1f40, 0x0300, 0x1f42 },
+	{ 0x016b, 0x0308, 0x1e7b },
+	{ 0, 0, 0 },
+	{ 0x1f09, 0x0342, 0x1f0f },
+	{ 0, 0, 0 },
+	{ 0x1ff6, 0x0345, 0x1ff7 },
+	{ 0, 0, 0 },
+	{ 0x03c9, 0x0314, 0x1f61 },
+	{ 0x0443, 0x0304, 0x04ef },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x2273, 0x0338, 0x2275 },
+	{ 0x0049, 0x030f, 0x0208 },
+	{ 0, 0, 0 },
+	{ 0x0065, 0x0309, 0x1ebb },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0049, 0x0303, 0x0128 },
+	{ 0x21d0, 0x0338, 0x21cd },
+	{ 0, 0, 0 },
+	{ 0x1f48, 0x0300, 0x1f4a },
+	{ 0, 0, 0 },
+	{ 0x014c, 0x0301, 0x1e52 },
+	{ 0x0112, 0x0301, 0x1e16 },
+	{ 0x0079, 0x0301, 0x00fd },
+	{ 0x2264, 0x0338, 0x2270 },
+	{ 0, 0, 0 },
+	{ 0x1f21, 0x0342, 0x1f27 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03ca, 0x0342, 0x1fd7 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004b, 0x030c, 0x01e8 },
+	{ 0x0041, 0x0308, 0x00c4 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x3075, 0x309a, 0x3077 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f0a, 0x0345, 0x1f8a },
+	{ 0x004e, 0x030c, 0x0147 },
+	{ 0x01b0, 0x0300, 0x1eeb },
+	{ 0x0068, 0x0302, 0x0125 },
+	{ 0x004c, 0x030c, 0x013d },
+	{ 0, 0, 0 },
+	{ 0x1f07, 0x0345, 0x1f87 },
+	{ 0x0397, 0x0313, 0x1f28 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004f, 0x031b, 0x01a0 },
+	{ 0, 0, 0 },
+	{ 0x0395, 0x0301, 0x0388 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0048, 0x0307, 0x1e22 },
+	{ 0x00e5, 0x0301, 0x01fb },
+	{ 0x0065, 0x0330, 0x1e1b },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30fd, 0x3099, 0x30fe },
+	{ 0x3051, 0x3099, 0x3052 },
+	{ 0x0055, 0x0309, 0x1ee6 },
+	{ 0x0075, 0x0303, 0x0169 },
+	{ 0x1f09, 0x0301, 0x1f0d },
+	{ 0, 0, 0 },
+	{ 0x0047, 0x0307, 0x0120 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x22a2, 0x0338, 0x22ac },
+	{ 0x0074, 0x0326, 0x021b },
+	{ 0x006e, 0x0307, 0x1e45 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0228, 0x0306, 0x1e1c },
+	{ 0x307b, 0x309a, 0x307d },
+	{ 0x00d5, 0x0308, 0x1e4e },
+	{ 0x00f6, 0x0304, 0x022b },
+	{ 0x0045, 0x0302, 0x00ca },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0059, 0x0308, 0x0178 },
+	{ 0, 0, 0 },
+	{ 0x1f67, 0x0345, 0x1fa7 },
+	{ 0, 0, 0 },
+	{ 0x00f4, 0x0300, 0x1ed3 },
+	{ 0x006e, 0x0331, 0x1e49 },
+	{ 0x0064, 0x032d, 0x1e13 },
+	{ 0x1fc6, 0x0345, 0x1fc7 },
+	{ 0x0443, 0x0306, 0x045e },
+	{ 0x0076, 0x0323, 0x1e7f },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x006f, 0x030f, 0x020d },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00f8, 0x0301, 0x01ff },
+	{ 0x004c, 0x0301, 0x0139 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0b47, 0x0b57, 0x0b4c },
+	{ 0x3064, 0x3099, 0x3065 },
+	{ 0, 0, 0 },
+	{ 0x0930, 0x093c, 0x0931 },
+	{ 0, 0, 0 },
+	{ 0x006f, 0x0307, 0x022f },
+	{ 0x2286, 0x0338, 0x2288 },
+	{ 0x0079, 0x0303, 0x1ef9 },
+	{ 0x22b5, 0x0338, 0x22ed },
+	{ 0, 0, 0 },
+	{ 0x1f65, 0x0345, 0x1fa5 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03b9, 0x0304, 0x1fd1 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0041, 0x030a, 0x00c5 },
+	{ 0x00d4, 0x0300, 0x1ed2 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f0f, 0x0345, 0x1f8f },
+	{ 0, 0, 0 },
+	{ 0x06d5, 0x0654, 0x06c0 },
+	{ 0, 0, 0 },
+	{ 0x0041, 0x030c, 0x01cd },
+	{ 0x03a5, 0x0304, 0x1fe9 },
+	{ 0x1f2d, 0x0345, 0x1f9d },
+	{ 0x0068, 0x0327, 0x1e29 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0075, 0x031b, 0x01b0 },
+	{ 0x2245, 0x0338, 0x2247 },
+	{ 0, 0, 0 },
+	{ 0x01a0, 0x0309, 0x1ede },
+	{ 0x30d5, 0x3099, 0x30d6 },
+	{ 0, 0, 0 },
+	{ 0x0069, 0x0330, 0x1e2d },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0077, 0x0307, 0x1e87 },
+	{ 0x0056, 0x0303, 0x1e7c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f70, 0x0345, 0x1fb2 },
+	{ 0x1f0d, 0x0345, 0x1f8d },
+	{ 0x0073, 0x0307, 0x1e61 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0397, 0x0300, 0x1fca },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004f, 0x0308, 0x00d6 },
+	{ 0x0112, 0x0300, 0x1e14 },
+	{ 0x1b07, 0x1b35, 0x1b08 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03c5, 0x0308, 0x03cb },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f7c, 0x0345, 0x1ff2 },
+	{ 0, 0, 0 },
+	{ 0x0045, 0x0304, 0x0112 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0048, 0x0308, 0x1e26 },
+	{ 0x1f6b, 0x0345, 0x1fab },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0416, 0x0308, 0x04dc },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0047, 0x0301, 0x01f4 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x305f, 0x3099, 0x3060 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0064, 0x0307, 0x1e0b },
+	{ 0x004f, 0x0307, 0x022e },
+	{ 0x0045, 0x0330, 0x1e1a },
+	{ 0x00a8, 0x0342, 0x1fc1 },
+	{ 0, 0, 0 },
+	{ 0x03b1, 0x0314, 0x1f01 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03b9, 0x0306, 0x1fd0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x006c, 0x030c, 0x013e },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x007a, 0x0331, 0x1e95 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30d5, 0x309a, 0x30d7 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1ecd, 0x0302, 0x1ed9 },
+	{ 0x01eb, 0x0304, 0x01ed },
+	{ 0, 0, 0 },
+	{ 0x0399, 0x0304, 0x1fd9 },
+	{ 0, 0, 0 },
+	{ 0x1f08, 0x0342, 0x1f0e },
+	{ 0x1f28, 0x0345, 0x1f98 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0052, 0x030f, 0x0210 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x005a, 0x0301, 0x0179 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30c8, 0x3099, 0x30c9 },
+	{ 0x3072, 0x3099, 0x3073 },
+	{ 0x00c2, 0x0303, 0x1eaa },
+	{ 0x1e62, 0x0307, 0x1e68 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00ea, 0x0303, 0x1ec5 },
+	{ 0x0067, 0x0307, 0x0121 },
+	{ 0, 0, 0 },
+	{ 0x006f, 0x0328, 0x01eb },
+	{ 0x0399, 0x0314, 0x1f39 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0427, 0x0308, 0x04f4 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x006b, 0x0323, 0x1e33 },
+	{ 0x0054, 0x030c, 0x0164 },
+	{ 0x0045, 0x0306, 0x0114 },
+	{ 0x00e2, 0x0300, 0x1ea7 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f31, 0x0300, 0x1f33 },
+	{ 0x0d47, 0x0d3e, 0x0d4b },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0064, 0x0331, 0x1e0f },
+	{ 0, 0, 0 },
+	{ 0x0078, 0x0308, 0x1e8d },
+	{ 0x004b, 0x0327, 0x0136 },
+	{ 0x0041, 0x0323, 0x1ea0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03c9, 0x0301, 0x03ce },
+	{ 0x0102, 0x0309, 0x1eb2 },
+	{ 0x30ad, 0x3099, 0x30ae },
+	{ 0, 0, 0 },
+	{ 0x0bc7, 0x0bbe, 0x0bcb },
+	{ 0x1ffe, 0x0301, 0x1fde },
+	{ 0, 0, 0 },
+	{ 0x03c9, 0x0342, 0x1ff6 },
+	{ 0, 0, 0 },
+	{ 0x30db, 0x3099, 0x30dc },
+	{ 0, 0, 0 },
+	{ 0x1f64, 0x0345, 0x1fa4 },
+	{ 0x1e37, 0x0304, 0x1e39 },
+	{ 0, 0, 0 },
+	{ 0x0079, 0x0307, 0x1e8f },
+	{ 0, 0, 0 },
+	{ 0x0063, 0x0327, 0x00e7 },
+	{ 0x22ab, 0x0338, 0x22af },
+	{ 0x21d4, 0x0338, 0x21ce },
+	{ 0x1f68, 0x0342, 0x1f6e },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0435, 0x0306, 0x04d7 },
+	{ 0x0044, 0x0331, 0x1e0e },
+	{ 0x03a5, 0x0300, 0x1fea },
+	{ 0x0067, 0x030c, 0x01e7 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0079, 0x0302, 0x0177 },
+	{ 0x0049, 0x0300, 0x00cc },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0395, 0x0300, 0x1fc8 },
+	{ 0x00fc, 0x030c, 0x01da },
+	{ 0, 0, 0 },
+	{ 0x0399, 0x0306, 0x1fd8 },
+	{ 0x0041, 0x0300, 0x00c0 },
+	{ 0x004c, 0x0331, 0x1e3a },
+	{ 0x03c5, 0x0304, 0x1fe1 },
+	{ 0x1f23, 0x0345, 0x1f93 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0052, 0x0311, 0x0212 },
+	{ 0x30ef, 0x3099, 0x30f7 },
+	{ 0x0069, 0x0309, 0x1ec9 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0069, 0x0303, 0x0129 },
+	{ 0, 0, 0 },
+	{ 0x0169, 0x0301, 0x1e79 },
+	{ 0x0bc6, 0x0bbe, 0x0bca },
+	{ 0x0055, 0x0303, 0x0168 },
+	{ 0, 0, 0 },
+	{ 0x1f50, 0x0301, 0x1f54 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03b7, 0x0313, 0x1f20 },
+	{ 0, 0, 0 },
+	{ 0x03c1, 0x0313, 0x1fe4 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03bf, 0x0314, 0x1f41 },
+	{ 0, 0, 0 },
+	{ 0x044d, 0x0308, 0x04ed },
+	{ 0x0418, 0x0304, 0x04e2 },
+	{ 0, 0, 0 },
+	{ 0x004e, 0x032d, 0x1e4a },
+	{ 0x007a, 0x030c, 0x017e },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0061, 0x0302, 0x00e2 },
+	{ 0x03a1, 0x0314, 0x1fec },
+	{ 0x0397, 0x0345, 0x1fcc },
+	{ 0, 0, 0 },
+	{ 0x30cf, 0x309a, 0x30d1 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f21, 0x0345, 0x1f91 },
+	{ 0x1f41, 0x0300, 0x1f43 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0055, 0x032d, 0x1e76 },
+	{ 0x1f61, 0x0345, 0x1fa1 },
+	{ 0x1f0b, 0x0345, 0x1f8b },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x04d9, 0x0308, 0x04db },
+	{ 0, 0, 0 },
+	{ 0x0065, 0x0311, 0x0207 },
+	{ 0x0068, 0x032e, 0x1e2b },
+	{ 0, 0, 0 },
+	{ 0x004b, 0x0323, 0x1e32 },
+	{ 0, 0, 0 },
+	{ 0x006e, 0x0327, 0x0146 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f02, 0x0345, 0x1f82 },
+	{ 0x1f38, 0x0301, 0x1f3c },
+	{ 0, 0, 0 },
+	{ 0x0043, 0x0307, 0x010a },
+	{ 0x227b, 0x0338, 0x2281 },
+	{ 0x0052, 0x0301, 0x0154 },
+	{ 0x00ca, 0x0309, 0x1ec2 },
+	{ 0x2225, 0x0338, 0x2226 },
+	{ 0x1f38, 0x0342, 0x1f3e },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0430, 0x0306, 0x04d1 },
+	{ 0, 0, 0 },
+	{ 0x03cb, 0x0300, 0x1fe2 },
+	{ 0x0227, 0x0304, 0x01e1 },
+	{ 0, 0, 0 },
+	{ 0x0058, 0x0308, 0x1e8c },
+	{ 0x0074, 0x0331, 0x1e6f },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f63, 0x0345, 0x1fa3 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0041, 0x0302, 0x00c2 },
+	{ 0x0072, 0x0331, 0x1e5f },
+	{ 0x0055, 0x030a, 0x016e },
+	{ 0x1f74, 0x0345, 0x1fc2 },
+	{ 0x0415, 0x0306, 0x04d6 },
+	{ 0x1f20, 0x0342, 0x1f26 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x2272, 0x0338, 0x2274 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00fc, 0x0301, 0x01d8 },
+	{ 0x0050, 0x0301, 0x1e54 },
+	{ 0x0627, 0x0654, 0x0623 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x3068, 0x3099, 0x3069 },
+	{ 0x0079, 0x0309, 0x1ef7 },
+	{ 0x03b9, 0x0301, 0x03af },
+	{ 0x1f20, 0x0301, 0x1f24 },
+	{ 0, 0, 0 },
+	{ 0x01a0, 0x0303, 0x1ee0 },
+	{ 0x2203, 0x0338, 0x2204 },
+	{ 0x004e, 0x0303, 0x00d1 },
+	{ 0, 0, 0 },
+	{ 0x0065, 0x0328, 0x0119 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0cbf, 0x0cd5, 0x0cc0 },
+	{ 0x0418, 0x0306, 0x0419 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0075, 0x030c, 0x01d4 },
+	{ 0, 0, 0 },
+	{ 0x0061, 0x0304, 0x0101 },
+	{ 0x0103, 0x0300, 0x1eb1 },
+	{ 0x1f00, 0x0300, 0x1f02 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x2243, 0x0338, 0x2244 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x003e, 0x0338, 0x226f },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f06, 0x0345, 0x1f86 },
+	{ 0x0062, 0x0323, 0x1e05 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03bf, 0x0301, 0x03cc },
+	{ 0, 0, 0 },
+	{ 0x0072, 0x0307, 0x1e59 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30a6, 0x3099, 0x30f4 },
+	{ 0, 0, 0 },
+	{ 0x01a1, 0x0309, 0x1edf },
+	{ 0x1f08, 0x0301, 0x1f0c },
+	{ 0, 0, 0 },
+	{ 0x1b09, 0x1b35, 0x1b0a },
+	{ 0x0063, 0x0301, 0x0107 },
+	{ 0, 0, 0 },
+	{ 0x2276, 0x0338, 0x2278 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x041a, 0x0301, 0x040c },
+	{ 0x01af, 0x0323, 0x1ef0 },
+	{ 0x0443, 0x030b, 0x04f3 },
+	{ 0x1fbf, 0x0300, 0x1fcd },
+	{ 0, 0, 0 },
+	{ 0x0cc6, 0x0cd6, 0x0cc8 },
+	{ 0x00f5, 0x0304, 0x022d },
+	{ 0x006f, 0x0302, 0x00f4 },
+	{ 0, 0, 0 },
+	{ 0x1b0b, 0x1b35, 0x1b0c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0067, 0x0306, 0x011f },
+	{ 0, 0, 0 },
+	{ 0x0042, 0x0331, 0x1e06 },
+	{ 0, 0, 0 },
+	{ 0x1f6f, 0x0345, 0x1faf },
+	{ 0x0054, 0x0327, 0x0162 },
+	{ 0x0075, 0x0323, 0x1ee5 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03d2, 0x0301, 0x03d3 },
+	{ 0, 0, 0 },
+	{ 0x304f, 0x3099, 0x3050 },
+	{ 0x014d, 0x0301, 0x1e53 },
+	{ 0, 0, 0 },
+	{ 0x004b, 0x0301, 0x1e30 },
+	{ 0x1f11, 0x0301, 0x1f15 },
+	{ 0x003c, 0x0338, 0x226e },
+	{ 0, 0, 0 },
+	{ 0x30b9, 0x3099, 0x30ba },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x22b4, 0x0338, 0x22ec },
+	{ 0x2208, 0x0338, 0x2209 },
+	{ 0x03b5, 0x0314, 0x1f11 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0418, 0x0308, 0x04e4 },
+	{ 0x0064, 0x0323, 0x1e0d },
+	{ 0x0045, 0x0327, 0x0228 },
+	{ 0x004f, 0x0323, 0x1ecc },
+	{ 0x0045, 0x030c, 0x011a },
+	{ 0x0061, 0x0306, 0x0103 },
+	{ 0x00a8, 0x0300, 0x1fed },
+	{ 0x043e, 0x0308, 0x04e7 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1b42, 0x1b35, 0x1b43 },
+	{ 0x30b5, 0x3099, 0x30b6 },
+	{ 0x1f00, 0x0345, 0x1f80 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x039f, 0x0300, 0x1ff8 },
+	{ 0x0077, 0x0308, 0x1e85 },
+	{ 0x1f2c, 0x0345, 0x1f9c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0042, 0x0307, 0x1e02 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x304b, 0x3099, 0x304c },
+	{ 0, 0, 0 },
+	{ 0x0627, 0x0655, 0x0625 },
+	{ 0x015b, 0x0307, 0x1e65 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x006c, 0x0301, 0x013a },
+	{ 0x0061, 0x030f, 0x0201 },
+	{ 0x0102, 0x0301, 0x1eae },
+	{ 0x1f0c, 0x0345, 0x1f8c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x042b, 0x0308, 0x04f8 },
+	{ 0x03a5, 0x0306, 0x1fe8 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0079, 0x0308, 0x00ff },
+	{ 0x0049, 0x0306, 0x012c },
+	{ 0x0065, 0x0300, 0x00e8 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0067, 0x0304, 0x1e21 },
+	{ 0x30d8, 0x309a, 0x30da },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f60, 0x0300, 0x1f62 },
+	{ 0x1eb9, 0x0302, 0x1ec7 },
+	{ 0x0043, 0x030c, 0x010c },
+	{ 0x0397, 0x0314, 0x1f29 },
+	{ 0x0068, 0x0331, 0x1e96 },
+	{ 0, 0, 0 },
+	{ 0x1f6a, 0x0345, 0x1faa },
+	{ 0, 0, 0 },
+	{ 0x0045, 0x0323, 0x1eb8 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0417, 0x0308, 0x04de },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0076, 0x0303, 0x1e7d },
+	{ 0, 0, 0 },
+	{ 0x004c, 0x0327, 0x013b },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004f, 0x0301, 0x00d3 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f41, 0x0301, 0x1f45 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0b92, 0x0bd7, 0x0b94 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03a9, 0x0300, 0x1ffa },
+	{ 0x006b, 0x030c, 0x01e9 },
+	{ 0x0061, 0x0308, 0x00e4 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1ecc, 0x0302, 0x1ed8 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0047, 0x030c, 0x01e6 },
+	{ 0x0073, 0x0302, 0x015d },
+	{ 0x01b0, 0x0323, 0x1ef1 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x006f, 0x031b, 0x01a1 },
+	{ 0, 0, 0 },
+	{ 0x03b5, 0x0301, 0x03ad },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0068, 0x0307, 0x1e23 },
+	{ 0x0059, 0x0301, 0x00dd },
+	{ 0x0072, 0x0327, 0x0157 },
+	{ 0x1f68, 0x0301, 0x1f6c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0dd9, 0x0dca, 0x0dda },
+	{ 0, 0, 0 },
+	{ 0x1f26, 0x0345, 0x1f96 },
+	{ 0x1f29, 0x0301, 0x1f2d },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00ea, 0x0301, 0x1ebf },
+	{ 0x0061, 0x0301, 0x00e1 },
+	{ 0x06d2, 0x0654, 0x06d3 },
+	{ 0, 0, 0 },
+	{ 0x1f29, 0x0342, 0x1f2f },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03a5, 0x0308, 0x03ab },
+	{ 0x0056, 0x0323, 0x1e7e },
+	{ 0x0391, 0x0300, 0x1fba },
+	{ 0x1f28, 0x0300, 0x1f2a },
+	{ 0x00f5, 0x0308, 0x1e4f },
+	{ 0x0049, 0x0308, 0x00cf },
+	{ 0x0065, 0x0302, 0x00ea },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x227a, 0x0338, 0x2280 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x039f, 0x0313, 0x1f48 },
+	{ 0, 0, 0 },
+	{ 0x0418, 0x0300, 0x040d },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0069, 0x0311, 0x020b },
+	{ 0x30d8, 0x3099, 0x30d9 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0041, 0x0301, 0x00c1 },
+	{ 0x1e63, 0x0307, 0x1e69 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x3059, 0x3099, 0x305a },
+	{ 0x3072, 0x309a, 0x3074 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x01a1, 0x0301, 0x1edb },
+	{ 0x03a9, 0x0313, 0x1f68 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f2b, 0x0345, 0x1f9b },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0061, 0x030a, 0x00e5 },
+	{ 0, 0, 0 },
+	{ 0x1b3f, 0x1b35, 0x1b41 },
+	{ 0x1f49, 0x0300, 0x1f4b },
+	{ 0x03ae, 0x0345, 0x1fc4 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0391, 0x0306, 0x1fb8 },
+	{ 0, 0, 0 },
+	{ 0x1f18, 0x0300, 0x1f1a },
+	{ 0, 0, 0 },
+	{ 0x00fc, 0x0300, 0x01dc },
+	{ 0x004b, 0x0331, 0x1e34 },
+	{ 0x006c, 0x032d, 0x1e3d },
+	{ 0, 0, 0 },
+	{ 0x1f22, 0x0345, 0x1f92 },
+	{ 0x03b7, 0x0314, 0x1f21 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f61, 0x0301, 0x1f65 },
+	{ 0, 0, 0 },
+	{ 0x0063, 0x0307, 0x010b },
+	{ 0x00d5, 0x0301, 0x1e4c },
+	{ 0, 0, 0 },
+	{ 0x1f18, 0x0301, 0x1f1c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x2292, 0x0338, 0x22e3 },
+	{ 0x223c, 0x0338, 0x2241 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0438, 0x0300, 0x045d },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00e6, 0x0304, 0x01e3 },
+	{ 0x00dc, 0x0300, 0x01db },
+	{ 0x1f51, 0x0300, 0x1f53 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x3078, 0x309a, 0x307a },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0079, 0x030a, 0x1e99 },
+	{ 0x1f60, 0x0345, 0x1fa0 },
+	{ 0x03c5, 0x0313, 0x1f50 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0075, 0x0324, 0x1e73 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0055, 0x030b, 0x0170 },
+	{ 0x0113, 0x0301, 0x1e17 },
+	{ 0x0067, 0x0301, 0x01f5 },
+	{ 0x00dc, 0x0301, 0x01d7 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x2190, 0x0338, 0x219a },
+	{ 0x1f6e, 0x0345, 0x1fae },
+	{ 0, 0, 0 },
+	{ 0x01a1, 0x0303, 0x1ee1 },
+	{ 0x0065, 0x030f, 0x0205 },
+	{ 0, 0, 0 },
+	{ 0x0059, 0x0303, 0x1ef8 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0073, 0x0323, 0x1e63 },
+	{ 0x03ca, 0x0300, 0x1fd2 },
+	{ 0x0226, 0x0304, 0x01e0 },
+	{ 0x03b7, 0x0345, 0x1fc3 },
+	{ 0, 0, 0 },
+	{ 0x0048, 0x0302, 0x0124 },
+	{ 0x1b3a, 0x1b35, 0x1b3b },
+	{ 0x03a9, 0x0345, 0x1ffc },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1ea1, 0x0306, 0x1eb7 },
+	{ 0x1f69, 0x0300, 0x1f6b },
+	{ 0, 0, 0 },
+	{ 0x006f, 0x0308, 0x00f6 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0079, 0x0323, 0x1ef5 },
+	{ 0x004f, 0x0306, 0x014e },
+	{ 0, 0, 0 },
+	{ 0x0069, 0x0328, 0x012f },
+	{ 0x041e, 0x0308, 0x04e6 },
+	{ 0, 0, 0 },
+	{ 0x0160, 0x0307, 0x1e66 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x007a, 0x0301, 0x017a },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30bd, 0x3099, 0x30be },
+	{ 0x30f2, 0x3099, 0x30fa },
+	{ 0, 0, 0 },
+	{ 0x0053, 0x0301, 0x015a },
+	{ 0x1f30, 0x0300, 0x1f32 },
+	{ 0, 0, 0 },
+	{ 0x00ca, 0x0303, 0x1ec4 },
+	{ 0x0045, 0x030f, 0x0204 },
+	{ 0x0397, 0x0301, 0x0389 },
+	{ 0, 0, 0 },
+	{ 0x03b9, 0x0314, 0x1f31 },
+	{ 0x03c9, 0x0313, 0x1f60 },
+	{ 0, 0, 0 },
+	{ 0x0bc6, 0x0bd7, 0x0bcc },
+	{ 0, 0, 0 },
+	{ 0x0391, 0x0304, 0x1fb9 },
+	{ 0x0044, 0x032d, 0x1e12 },
+	{ 0x0049, 0x030c, 0x01cf },
+	{ 0x0065, 0x0306, 0x0115 },
+	{ 0x0102, 0x0300, 0x1eb0 },
+	{ 0, 0, 0 },
+	{ 0x1eb8, 0x0302, 0x1ec6 },
+	{ 0x0391, 0x0345, 0x1fbc },
+	{ 0x0933, 0x093c, 0x0934 },
+	{ 0x0075, 0x0300, 0x00f9 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0055, 0x0304, 0x016a },
+	{ 0x006f, 0x0300, 0x00f2 },
+	{ 0x006e, 0x0300, 0x01f9 },
+	{ 0, 0, 0 },
+	{ 0x1f05, 0x0345, 0x1f85 },
+	{ 0x0395, 0x0313, 0x1f18 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30d2, 0x3099, 0x30d3 },
+	{ 0x0046, 0x0307, 0x1e1e },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f04, 0x0345, 0x1f84 },
+	{ 0x1f59, 0x0300, 0x1f5b },
+	{ 0x306f, 0x309a, 0x3071 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f66, 0x0345, 0x1fa6 },
+	{ 0x0041, 0x0309, 0x1ea2 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x01a0, 0x0323, 0x1ee2 },
+	{ 0, 0, 0 },
+	{ 0x03c5, 0x0300, 0x1f7a },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00ea, 0x0300, 0x1ec1 },
+	{ 0x0069, 0x0300, 0x00ec },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1b3c, 0x1b35, 0x1b3d },
+	{ 0x1f39, 0x0300, 0x1f3b },
+	{ 0, 0, 0 },
+	{ 0x01af, 0x0300, 0x1eea },
+	{ 0x0077, 0x0300, 0x1e81 },
+	{ 0x006c, 0x0331, 0x1e3b },
+	{ 0, 0, 0 },
+	{ 0x01a1, 0x0323, 0x1ee3 },
+	{ 0x0475, 0x030f, 0x0477 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0072, 0x0311, 0x0213 },
+	{ 0x30cf, 0x3099, 0x30d0 },
+	{ 0, 0, 0 },
+	{ 0x0059, 0x0307, 0x1e8e },
+	{ 0x004f, 0x0303, 0x00d5 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0054, 0x0307, 0x1e6a },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0061, 0x0307, 0x0227 },
+	{ 0, 0, 0 },
+	{ 0x0075, 0x030f, 0x0215 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0055, 0x0324, 0x1e72 },
+	{ 0, 0, 0 },
+	{ 0x1f50, 0x0342, 0x1f56 },
+	{ 0x0438, 0x0304, 0x04e3 },
+	{ 0, 0, 0 },
+	{ 0x004e, 0x0323, 0x1e46 },
+	{ 0x006f, 0x030c, 0x01d2 },
+	{ 0x0065, 0x0308, 0x00eb },
+	{ 0x00dc, 0x0304, 0x01d5 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0075, 0x0306, 0x016d },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f21, 0x0300, 0x1f23 },
+	{ 0x0055, 0x0306, 0x016c },
+	{ 0x0423, 0x0306, 0x040e },
+	{ 0x03b1, 0x0304, 0x1fb1 },
+	{ 0x0075, 0x032d, 0x1e77 },
+	{ 0, 0, 0 },
+	{ 0x0061, 0x0325, 0x1e01 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x043a, 0x0301, 0x045c },
+	{ 0x0048, 0x032e, 0x1e2a },
+	{ 0x0049, 0x0328, 0x012e },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03b1, 0x0342, 0x1fb6 },
+	{ 0, 0, 0 },
+	{ 0x03b9, 0x0342, 0x1fd6 },
+	{ 0, 0, 0 },
+	{ 0x0073, 0x0301, 0x015b },
+	{ 0x3075, 0x3099, 0x3076 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0075, 0x0309, 0x1ee7 },
+	{ 0, 0, 0 },
+	{ 0x006d, 0x0301, 0x1e3f },
+	{ 0x0399, 0x0301, 0x038a },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0dd9, 0x0ddf, 0x0dde },
+	{ 0x006e, 0x032d, 0x1e4b },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00c4, 0x0304, 0x01de },
+	{ 0x0069, 0x0302, 0x00ee },
+	{ 0, 0, 0 },
+	{ 0x1b05, 0x1b35, 0x1b06 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f29, 0x0345, 0x1f99 },
+	{ 0x1f09, 0x0300, 0x1f0b },
+	{ 0x00c6, 0x0304, 0x01e2 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004e, 0x0327, 0x0145 },
+	{ 0x006f, 0x0323, 0x1ecd },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0059, 0x0309, 0x1ef6 },
+	{ 0x0054, 0x032d, 0x1e70 },
+	{ 0x0070, 0x0301, 0x1e55 },
+	{ 0x0045, 0x0301, 0x00c9 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x305d, 0x3099, 0x305e },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f40, 0x0301, 0x1f44 },
+	{ 0, 0, 0 },
+	{ 0x0066, 0x0307, 0x1e1f },
+	{ 0x00a8, 0x0301, 0x0385 },
+	{ 0x0075, 0x0301, 0x00fa },
+	{ 0x2283, 0x0338, 0x2285 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x04e9, 0x0308, 0x04eb },
+	{ 0x0438, 0x0306, 0x0439 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x006a, 0x030c, 0x01f0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0075, 0x0304, 0x016b },
+	{ 0x0b47, 0x0b56, 0x0b48 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30ab, 0x3099, 0x30ac },
+	{ 0x1ea0, 0x0302, 0x1eac },
+	{ 0, 0, 0 },
+	{ 0x0049, 0x0302, 0x00ce },
+	{ 0x004e, 0x0300, 0x01f8 },
+	{ 0x004f, 0x0300, 0x00d2 },
+	{ 0x0045, 0x032d, 0x1e18 },
+	{ 0x03b9, 0x0308, 0x03ca },
+	{ 0, 0, 0 },
+	{ 0x1f28, 0x0342, 0x1f2e },
+	{ 0x0423, 0x030b, 0x04f2 },
+	{ 0, 0, 0 },
+	{ 0x0430, 0x0308, 0x04d3 },
+	{ 0x0055, 0x0311, 0x0216 },
+	{ 0, 0, 0 },
+	{ 0x01b0, 0x0301, 0x1ee9 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30f1, 0x3099, 0x30f9 },
+	{ 0x30c6, 0x3099, 0x30c7 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x01b0, 0x0303, 0x1eef },
+	{ 0x09c7, 0x09d7, 0x09cc },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x2194, 0x0338, 0x21ae },
+	{ 0x006f, 0x0311, 0x020f },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0057, 0x0323, 0x1e88 },
+	{ 0, 0, 0 },
+	{ 0x0052, 0x030c, 0x0158 },
+	{ 0, 0, 0 },
+	{ 0x0069, 0x0304, 0x012b },
+	{ 0, 0, 0 },
+	{ 0x1f08, 0x0300, 0x1f0a },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30d2, 0x309a, 0x30d4 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f2e, 0x0345, 0x1f9e },
+	{ 0x014d, 0x0300, 0x1e51 },
+	{ 0, 0, 0 },
+	{ 0x0062, 0x0331, 0x1e07 },
+	{ 0x006a, 0x0302, 0x0135 },
+	{ 0x0627, 0x0653, 0x0622 },
+	{ 0x1f0e, 0x0345, 0x1f8e },
+	{ 0x21d2, 0x0338, 0x21cf },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0447, 0x0308, 0x04f5 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30af, 0x3099, 0x30b0 },
+	{ 0x007a, 0x0307, 0x017c },
+	{ 0x0045, 0x0303, 0x1ebc },
+	{ 0x006b, 0x0301, 0x1e31 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x03a9, 0x0301, 0x038f },
+	{ 0x1f10, 0x0301, 0x1f14 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00f4, 0x0303, 0x1ed7 },
+	{ 0, 0, 0 },
+	{ 0x22a9, 0x0338, 0x22ae },
+	{ 0x0055, 0x0328, 0x0172 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0438, 0x0308, 0x04e5 },
+	{ 0x0044, 0x0323, 0x1e0c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0065, 0x030c, 0x011b },
+	{ 0x0042, 0x0323, 0x1e04 },
+	{ 0x0077, 0x0302, 0x0175 },
+	{ 0x1b3e, 0x1b35, 0x1b40 },
+	{ 0x1f10, 0x0300, 0x1f12 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0648, 0x0654, 0x0624 },
+	{ 0, 0, 0 },
+	{ 0x1f28, 0x0301, 0x1f2c },
+	{ 0x006f, 0x0306, 0x014f },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0057, 0x0308, 0x1e84 },
+	{ 0, 0, 0 },
+	{ 0x03b1, 0x0313, 0x1f00 },
+	{ 0x0052, 0x0323, 0x1e5a },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0062, 0x0307, 0x1e03 },
+	{ 0x00d4, 0x0301, 0x1ed0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x30c1, 0x3099, 0x30c2 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f69, 0x0342, 0x1f6f },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00c7, 0x0301, 0x1e08 },
+	{ 0x0041, 0x030f, 0x0200 },
+	{ 0x2291, 0x0338, 0x22e2 },
+	{ 0, 0, 0 },
+	{ 0x0049, 0x0311, 0x020a },
+	{ 0, 0, 0 },
+	{ 0x044b, 0x0308, 0x04f9 },
+	{ 0x03c5, 0x0306, 0x1fe0 },
+	{ 0x006c, 0x0323, 0x1e37 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0069, 0x0306, 0x012d },
+	{ 0, 0, 0 },
+	{ 0x1e5a, 0x0304, 0x1e5c },
+	{ 0, 0, 0 },
+	{ 0x0047, 0x0304, 0x1e20 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0044, 0x030c, 0x010e },
+	{ 0x1f51, 0x0301, 0x1f55 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0044, 0x0327, 0x1e10 },
+	{ 0x0065, 0x0323, 0x1eb9 },
+	{ 0, 0, 0 },
+	{ 0x0049, 0x0323, 0x1eca },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004f, 0x0309, 0x1ece },
+	{ 0x0168, 0x0301, 0x1e78 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f21, 0x0301, 0x1f25 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x3053, 0x3099, 0x3054 },
+	{ 0x0069, 0x030f, 0x0209 },
+	{ 0x09c7, 0x09be, 0x09cb },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x227d, 0x0338, 0x22e1 },
+	{ 0, 0, 0 },
+	{ 0x1f62, 0x0345, 0x1fa2 },
+	{ 0x2223, 0x0338, 0x2224 },
+	{ 0x1f61, 0x0342, 0x1f67 },
+	{ 0x03a5, 0x0314, 0x1f59 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0059, 0x0323, 0x1ef4 },
+	{ 0x03c9, 0x0300, 0x1f7c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0047, 0x0302, 0x011c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x006f, 0x0304, 0x014d },
+	{ 0x022f, 0x0304, 0x0231 },
+	{ 0, 0, 0 },
+	{ 0x03b7, 0x0300, 0x1f74 },
+	{ 0x1ea0, 0x0306, 0x1eb6 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0043, 0x0302, 0x0108 },
+	{ 0x016a, 0x0308, 0x1e7a },
+	{ 0x0053, 0x0302, 0x015c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004d, 0x0323, 0x1e42 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x00d4, 0x0303, 0x1ed6 },
+	{ 0x00cf, 0x0301, 0x1e2e },
+	{ 0x004e, 0x0301, 0x0143 },
+	{ 0x1f48, 0x0301, 0x1f4c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x3066, 0x3099, 0x3067 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x006d, 0x0307, 0x1e41 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x2261, 0x0338, 0x2262 },
+	{ 0x220b, 0x0338, 0x220c },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0416, 0x0306, 0x04c1 },
+	{ 0, 0, 0 },
+	{ 0x03b1, 0x0300, 0x1f70 },
+	{ 0x0073, 0x030c, 0x0161 },
+	{ 0x0048, 0x030c, 0x021e },
+	{ 0x0069, 0x0308, 0x00ef },
+	{ 0x005a, 0x0302, 0x1e90 },
+	{ 0x0055, 0x0300, 0x00d9 },
+	{ 0x0073, 0x0326, 0x0219 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0055, 0x030c, 0x01d3 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f50, 0x0300, 0x1f52 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004f, 0x030c, 0x01d1 },
+	{ 0x0074, 0x0308, 0x1e97 },
+	{ 0x1f2f, 0x0345, 0x1f9f },
+	{ 0x03bf, 0x0313, 0x1f40 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0413, 0x0301, 0x0403 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x004f, 0x030b, 0x0150 },
+	{ 0x0045, 0x0307, 0x0116 },
+	{ 0x00e2, 0x0301, 0x1ea5 },
+	{ 0x0474, 0x030f, 0x0476 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f31, 0x0301, 0x1f35 },
+	{ 0, 0, 0 },
+	{ 0x005a, 0x0307, 0x017b },
+	{ 0, 0, 0 },
+	{ 0x1f69, 0x0345, 0x1fa9 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x1f31, 0x0342, 0x1f37 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0, 0, 0 },
+	{ 0x0399, 0x0300, 0x1fda },
+	{ 0x00dc, 0x030c, 0x01d9 },
+	{ 0, 0, 0 },
+	{ 0x006b, 0x0327, 0x0137 },
+	{ 0x1ffe, 0x0300, 0x1fdd },
+	{ 0, 0, 0 },
+	{ 0x03ce, 0x0345, 0x1ff4 },
+	{ 0x0049, 0x0304, 0x012a },
+	{ 0x30db, 0x309a, 0x30dd },
+	{ 0, 0, 0 },
+	{ 0x06c1, 0x0654, 0x06c2 },
+	{ 0, 0, 0 },
+	{ 0x1f38, 0x0300, 0x1f3a },
+	{ 0x01a0, 0x0300, 0x1edc },
 };
 
 
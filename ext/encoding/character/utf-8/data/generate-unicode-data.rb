@@ -135,8 +135,18 @@ class CollectedData
 
     @casefold = []
     @casefold_longest = -1
+    @casefold_mappings = {}
 
     @bidimirror = []
+
+    @default_ignorables = {}
+
+    @collation_version = nil
+    @collation_elements = {}
+    @implicit_weights = []
+
+    @unified_ideographs = []
+    @core_ideograph_blocks = []
   end
 
   attr :dir
@@ -152,7 +162,14 @@ class CollectedData
   attr :special_cases, true
   attr :casefold, true
   attr :casefold_longest, true
+  attr :casefold_mappings, true
   attr :bidimirror, true
+  attr :default_ignorables, true
+  attr :collation_version, true
+  attr :collation_elements, true
+  attr :implicit_weights, true
+  attr :unified_ideographs, true
+  attr :core_ideograph_blocks, true
 end
 
 class CompositionExclusions
@@ -375,6 +392,7 @@ class CaseFolding
 	next if lower == values[0]
       end
 
+      data.casefold_mappings[code] = values
       string = values.pack('U*')
       if string.length + 1 > data.casefold_longest
 	data.casefold_longest = string.length + 1
@@ -395,6 +413,77 @@ class BidiMirroring
   end
 end
 
+class DerivedCoreProperties
+  def process(data)
+    path = File.join(data.dir, 'DerivedCoreProperties.txt')
+    File.process(path) do |line|
+      fields = line.chomp.sub(/\s*#.*/, '').split(/\s*;\s*/, -1)
+      fields.verify_size(2, path, 0)
+      next unless fields[1] == 'Default_Ignorable_Code_Point'
+      first, last = fields[0].split(/\.\./).map{ |s| s.to_i(16) }
+      first.upto(last || first){ |code| data.default_ignorables[code] = true }
+    end
+  end
+end
+
+class PropList
+  def process(data)
+    path = File.join(data.dir, 'PropList.txt')
+    File.process(path) do |line|
+      fields = line.chomp.sub(/\s*#.*/, '').split(/\s*;\s*/, -1)
+      fields.verify_size(2, path, 0)
+      next unless fields[1] == 'Unified_Ideograph'
+      first, last = fields[0].split(/\.\./).map{ |s| s.to_i(16) }
+      data.unified_ideographs.push([first, last || first])
+    end
+  end
+end
+
+class Blocks
+  CoreIdeographBlocks = ['CJK Unified Ideographs', 'CJK Compatibility Ideographs']
+
+  def process(data)
+    path = File.join(data.dir, 'Blocks.txt')
+    File.process(path) do |line|
+      fields = line.chomp.sub(/\s*#.*/, '').split(/\s*;\s*/, -1)
+      fields.verify_size(2, path, 0)
+      next unless CoreIdeographBlocks.include? fields[1]
+      first, last = fields[0].split(/\.\./).map{ |s| s.to_i(16) }
+      data.core_ideograph_blocks.push([first, last])
+    end
+  end
+end
+
+class Collation
+  def process(data)
+    path = File.join(data.dir, 'allkeys.txt')
+    File.process(path) do |line|
+      case line
+      when /^@version\s+(\S+)/
+	data.collation_version = $1
+	next
+      when /^@implicitweights\s+([0-9A-F]+)\.\.([0-9A-F]+)\s*;\s*([0-9A-F]+)/
+	data.implicit_weights.push([$1.to_i(16), $2.to_i(16), $3.to_i(16)])
+	next
+      when /^@/
+	next
+      end
+      fields = line.chomp.sub(/\s*#.*/, '').split(/\s*;\s*/, -1)
+      fields.verify_size(2, path, 0)
+      codes = fields[0].split(/\s+/).map{ |s| s.to_i(16) }
+      elements = fields[1].scan(/\[([.*])([0-9A-F]{4})\.([0-9A-F]{4})\.([0-9A-F]{4})\]/)
+      if elements.empty?
+	error("entry doesn't contain any collation elements:\n" +
+	      "    file: %s\n" +
+	      "    entry: %s\n", path, fields[0])
+      end
+      data.collation_elements[codes] = elements.map do |variable, *weights|
+	weights.map{ |weight| weight.to_i(16) }.push(variable == '*')
+      end
+    end
+  end
+end
+
 class Printer
   def initialize
     @index = 0
@@ -408,6 +497,7 @@ class Printer
     print_decomp(data)
     print_composition_table(data)
     print_line_break(data)
+    print_collation(data)
   end
 
 private
@@ -585,6 +675,7 @@ EOF
 
       print_special_case_table(data)
       print_case_fold_table(data)
+      print_case_fold_direct_table(data)
 
       print <<EOF
 static const struct {
@@ -595,8 +686,10 @@ EOF
       data.bidimirror.each do |item|
 	printf("%s{ 0x%04x, 0x%04x },\n", data.indent, item[0], item[1])
       end
+      print("};\n")
+      print_index_table(data, 'bidi_mirroring',
+                        data.bidimirror.map{ |item| item[0] })
       print <<EOF
-};
 
 #endif /* #{header_h} */
 EOF
@@ -675,6 +768,85 @@ EOF
     end
     print <<EOF
 };
+EOF
+    print_index_table(data, 'casefold',
+                      data.casefold.sort_by{ |a| a[0] }.map{ |cf| cf[0] })
+  end
+
+  # Print a two-level table mapping each character onto one more than the
+  # index of its entry in the sorted table NAME_table, or onto 0 if it has no
+  # entry, so that NAME_table doesn't have to be searched.
+  def print_index_table(data, name, codes)
+    index = {}
+    codes.each_with_index{ |code, i| index[code] = i + 1 }
+    if codes.size > 0xffff
+      error("#{name}_index_data field too short.")
+    end
+    last = codes.max | 0xff
+    print_table(data, 0, last, last, 2, <<EOH, <<EOH1, ''){ |i| (index[i] || 0).to_s }
+
+
+/*
+ * Index into #{name}_table: one more than the index of the entry for a
+ * character, or 0 if it has none.
+ */
+static const uint16_t #{name}_index_data[][256] = {
+EOH
+
+
+static const int16_t #{name}_index_table[#{last / 256 + 1}] = {
+EOH1
+  end
+
+  CaseFoldDirectLast = 0x052f
+  CaseFoldDirectMultiple = 0xffff
+
+  def simple_lowercase(data, code)
+    case data.type[code]
+    when 'Lu'
+      value = data.value[code]
+      return nil if value >= 0x1000000
+      value == 0 ? code : value
+    when 'Lt'
+      data.title_to_lower[code]
+    else
+      code
+    end
+  end
+
+  def print_case_fold_direct_table(data)
+    print <<EOF
+
+/*
+ * Table of casefoldings for U+0000 through U+#{sprintf('%04X', CaseFoldDirectLast)}, that is, the Latin, Greek,
+ * and Cyrillic blocks, so that they can be looked up directly.  Characters
+ * that fold to more than one character are marked with
+ * UNICODE_CASEFOLD_DIRECT_MULTIPLE and have to be looked up in
+ * casefold_table.
+ */
+#define UNICODE_CASEFOLD_DIRECT_LAST #{sprintf('0x%04x', CaseFoldDirectLast)}
+
+#define UNICODE_CASEFOLD_DIRECT_MULTIPLE #{sprintf('0x%04x', CaseFoldDirectMultiple)}
+
+static const uint16_t casefold_direct_table[UNICODE_CASEFOLD_DIRECT_LAST + 1] = {
+EOF
+    0.step(CaseFoldDirectLast, 8) do |row|
+      print(data.indent)
+      row.upto(row + 7) do |code|
+	values = data.casefold_mappings[code] || [simple_lowercase(data, code)]
+	if values.size != 1 or values[0].nil?
+	  folded = CaseFoldDirectMultiple
+	elsif values[0] >= CaseFoldDirectMultiple
+	  error('casefold_direct_table field too short.' +
+		'  Upgrade to unichar to fit values beyond 0xfffe.')
+	else
+	  folded = values[0]
+	end
+	printf("0x%04x,%s", folded, code == row + 7 ? "\n" : ' ')
+      end
+    end
+    print <<EOF
+};
 EOF
   end
 
@@ -721,44 +893,97 @@ EOH2
       print <<EOL
 
 
+/*
+ * The canonical and compatibility decompositions of each character that has
+ * one, as offsets into and lengths in decomp_expansions.  A missing
+ * decomposition has offset UNICODE_NOT_PRESENT_OFFSET.  Entries are ordered
+ * by character and are found through decomp_index_table.
+ */
 static const struct {
-#{data.indent}unichar ch;
 #{data.indent}uint16_t canon_offset;
 #{data.indent}uint16_t compat_offset;
+#{data.indent}uint8_t canon_length;
+#{data.indent}uint8_t compat_length;
 } decomp_table[] = {
 EOL
       decomp_offsets = {}
-      decomp_string = ''
-      @decomp_string_offset = 0
+      decomp_expansions = ''
+      decomp_codes = []
+      @decomp_expansions_offset = 0
       0.upto(data.last) do |i|
 	unless data.decompositions[i].nil?
+	  decomp_codes.push(i)
 	  canon_decomp = data.decompose_compat[i] ?
 	    nil : make_decomp(data, i, false)
 	  compat_decomp = make_decomp(data, i, true)
 	  if not canon_decomp.nil? and compat_decomp == canon_decomp
 	    compat_decomp = nil
 	  end
-	  canon_offset = handle_decomp(canon_decomp, decomp_offsets,
-				       decomp_string)
-	  compat_offset = handle_decomp(compat_decomp, decomp_offsets,
-					decomp_string)
+	  canon_offset = handle_decomp(data, canon_decomp, decomp_offsets,
+				       decomp_expansions)
+	  compat_offset = handle_decomp(data, compat_decomp, decomp_offsets,
+					decomp_expansions)
 
-	  if @decomp_string_offset > NOT_PRESENT_OFFSET
-	    error('decomposition string offset beyond not-present-offset,' +
+	  if @decomp_expansions_offset > NOT_PRESENT_OFFSET
+	    error('decomposition expansions offset beyond not-present-offset,' +
 		  " upgrade value:\n" +
 		  "    offset: %d\n" +
 		  "    max: %d\n",
-		  @decomp_string_offset, NOT_PRESENT_OFFSET)
+		  @decomp_expansions_offset, NOT_PRESENT_OFFSET)
 	  end
-	  printf("%s{ 0x%04x, %s, %s },\n",
-		 data.indent, i, canon_offset, compat_offset)
+	  printf("%s{ %s, %s, %d, %d }, /* 0x%04x */\n",
+		 data.indent, canon_offset, compat_offset,
+		 canon_decomp.nil? ? 0 : canon_decomp.size,
+		 compat_decomp.nil? ? 0 : compat_decomp.size, i)
+	end
+      end
+      print("\n};")
+
+      print_index_table(data, 'decomp', decomp_codes)
+
+      nfkc_casefold = nfkc_casefold_mappings(data)
+      print <<EOL
+
+
+/*
+ * The NFKC_Casefold mappings of characters that have no canonical
+ * decomposition and that don't map to themselves, as offsets into and
+ * lengths in decomp_expansions.  Default ignorable code points map to
+ * nothing.  The mappings are decomposed but not in canonical order.
+ */
+static const struct {
+#{data.indent}uint16_t offset;
+#{data.indent}uint8_t length;
+} nfkc_casefold_table[] = {
+EOL
+      nfkc_casefold.keys.sort.each do |code|
+	mapping = nfkc_casefold[code]
+	offset = mapping.empty? ? 0 :
+	  handle_decomp(data, mapping, decomp_offsets, decomp_expansions)
+	if @decomp_expansions_offset > NOT_PRESENT_OFFSET
+	  error('NFKC_Casefold expansions offset beyond not-present-offset,' +
+		" upgrade value:\n" +
+		"    offset: %d\n" +
+		"    max: %d\n",
+		@decomp_expansions_offset, NOT_PRESENT_OFFSET)
 	end
+	printf("%s{ %s, %d }, /* 0x%04x */\n",
+	       data.indent, offset, mapping.size, code)
       end
       print("\n};")
 
+      print_index_table(data, 'nfkc_casefold', nfkc_casefold.keys.sort)
+
+      print_quick_check_table(data, nfkc_casefold)
+
       print <<EOL
 
-static const char decomp_expansion_string[] = #{decomp_string};
+/*
+ * The decompositions referred to by decomp_table, as sequences of code
+ * points.
+ */
+static const unichar decomp_expansions[] = {#{decomp_expansions}
+};
 
 
 #endif /* #{header_h} */
@@ -767,6 +992,133 @@ EOL
     $stdout = saved_stdout
   end
 
+  QuickCheckNFDNo = 0x01
+  QuickCheckNFKDNo = 0x02
+  QuickCheckNFCNo = 0x04
+  QuickCheckNFCMaybe = 0x08
+  QuickCheckNFKCNo = 0x10
+  QuickCheckNFKCMaybe = 0x20
+  QuickCheckNFKCCasefoldNo = 0x40
+
+  # Derive the NFD_QC, NFKD_QC, NFC_QC, and NFKC_QC properties of each
+  # character from its decomposition and the composition exclusions.
+  def quick_check_values(data, nfkc_casefold)
+    qc = Hash.new(0)
+    seconds = {}
+    data.decompositions.each_with_index do |decomp, code|
+      next if decomp.nil?
+      if data.decompose_compat[code]
+	qc[code] |= QuickCheckNFKDNo | QuickCheckNFKCNo
+	next
+      end
+      qc[code] |= QuickCheckNFDNo | QuickCheckNFKDNo
+      values = decomp.split(/ /).map{ |s| s.to_i(16) }
+      if data.excludes.include?(code) or values.size == 1 or
+	  data.cclass[values[0]] != '0'
+	qc[code] |= QuickCheckNFCNo | QuickCheckNFKCNo
+      else
+	seconds[values[1]] = true
+      end
+      if make_decomp(data, code, true) != make_decomp(data, code, false)
+	qc[code] |= QuickCheckNFKCNo
+      end
+    end
+    # Hangul syllables decompose algorithmically, and medial vowels and
+    # trailing consonants may combine with what precedes them.
+    0xac00.upto(0xd7a3){ |code| qc[code] |= QuickCheckNFDNo | QuickCheckNFKDNo }
+    (0x1161..0x1175).each{ |code| seconds[code] = true }
+    (0x11a8..0x11c2).each{ |code| seconds[code] = true }
+    seconds.each_key do |code|
+      qc[code] |= QuickCheckNFCMaybe | QuickCheckNFKCMaybe
+    end
+    # A character is changed by NFKC_Casefold if it isn't in NFKC or if it
+    # or anything in its canonical decomposition is mapped.
+    nfkc_casefold.each_key{ |code| qc[code] |= QuickCheckNFKCCasefoldNo }
+    data.decompositions.each_with_index do |decomp, code|
+      next if decomp.nil? or data.decompose_compat[code]
+      if make_decomp(data, code, false).any?{ |c| nfkc_casefold.include?(c) }
+	qc[code] |= QuickCheckNFKCCasefoldNo
+      end
+    end
+    qc.each_key do |code|
+      qc[code] |= QuickCheckNFKCCasefoldNo if qc[code] & QuickCheckNFKCNo != 0
+    end
+    qc
+  end
+
+  def case_fold(data, code)
+    data.casefold_mappings[code] || [simple_lowercase(data, code) || code]
+  end
+
+  def compat_decomposition(data, codes)
+    codes.map{ |c|
+      data.decompositions[c].nil? ? c : make_decomp(data, c, true)
+    }.flatten
+  end
+
+  # The NFKC_Casefold mapping of each character that has no canonical
+  # decomposition and doesn't map to itself.  A mapping is found by
+  # decomposing, case folding, decomposing again, and removing default
+  # ignorable code points until nothing changes.  Characters with canonical
+  # decompositions are mapped through the characters they decompose to.
+  def nfkc_casefold_mappings(data)
+    candidates = data.default_ignorables.keys + data.casefold_mappings.keys
+    0.upto(data.last) do |code|
+      if (not data.decompositions[code].nil? and data.decompose_compat[code]) or
+	  %w(Lu Lt).include?(data.type[code])
+	candidates.push(code)
+      end
+    end
+    mappings = {}
+    candidates.uniq.each do |code|
+      next if not data.decompositions[code].nil? and
+	not data.decompose_compat[code]
+      mapping = [code]
+      loop do
+	folded = compat_decomposition(data, mapping).map{ |c|
+	  case_fold(data, c)
+	}.flatten
+	folded = compat_decomposition(data, folded).reject{ |c|
+	  data.default_ignorables.include?(c)
+	}
+	break if folded == mapping
+	mapping = folded
+      end
+      mappings[code] = mapping unless mapping == [code]
+    end
+    mappings
+  end
+
+  def print_quick_check_table(data, nfkc_casefold)
+    qc = quick_check_values(data, nfkc_casefold)
+    last = qc.keys.max | 0xff
+    print <<EOF
+
+
+#define UNICODE_QUICK_CHECK_NFD_NO #{sprintf('0x%02x', QuickCheckNFDNo)}
+#define UNICODE_QUICK_CHECK_NFKD_NO #{sprintf('0x%02x', QuickCheckNFKDNo)}
+#define UNICODE_QUICK_CHECK_NFC_NO #{sprintf('0x%02x', QuickCheckNFCNo)}
+#define UNICODE_QUICK_CHECK_NFC_MAYBE #{sprintf('0x%02x', QuickCheckNFCMaybe)}
+#define UNICODE_QUICK_CHECK_NFKC_NO #{sprintf('0x%02x', QuickCheckNFKCNo)}
+#define UNICODE_QUICK_CHECK_NFKC_MAYBE #{sprintf('0x%02x', QuickCheckNFKCMaybe)}
+#define UNICODE_QUICK_CHECK_NFKC_CASEFOLD_NO #{sprintf('0x%02x', QuickCheckNFKCCasefoldNo)}
+EOF
+    print_table(data, 0, last, last, 1, <<EOH, <<EOH1, ''){ |i| qc[i].to_s }
+
+
+/*
+ * The normalization quick check properties of each character, as a
+ * combination of the UNICODE_QUICK_CHECK_* flags above.  Characters not
+ * covered by quick_check_table are normalized in all forms.
+ */
+static const uint8_t quick_check_data[][256] = {
+EOH
+
+
+static const int16_t quick_check_table[#{last / 256 + 1}] = {
+EOH1
+  end
+
   def expand_decomp(data, code, compat)
     ary = []
     data.decompositions[code].split(/ /).each do |item|
@@ -782,42 +1134,58 @@ EOL
   end
 
   def make_decomp(data, code, compat)
-    str = ''
-    expand_decomp(data, code, compat).each do |item|
-      str += item.is_a?(Array) ? item.flatten.pack('U') : [item].pack('U')
-    end
-    str
+    expand_decomp(data, code, compat).flatten
   end
 
-  def handle_decomp(decomp, decomp_offsets,
-		    decomp_string)
+  def handle_decomp(data, decomp, decomp_offsets,
+		    decomp_expansions)
     offset = 'UNICODE_NOT_PRESENT_OFFSET'
     unless decomp.nil?
+      if decomp.size > 255
+	error("decomposition too long to store its length:\n" +
+	      "    length: %d\n", decomp.size)
+      end
       if decomp_offsets.member?(decomp)
 	offset = decomp_offsets[decomp]
       else
-	offset = @decomp_string_offset
+	offset = @decomp_expansions_offset
 	decomp_offsets[decomp] = offset
-	decomp_string << ("\n  \"" + decomp.escape +
-			  "\\0\" /* offset #{offset} */")
-	@decomp_string_offset += decomp.length + 1
+	decomp_expansions << ("\n" + data.indent +
+			      decomp.map{ |c| sprintf('0x%04x,', c) }.join(' ') +
+			      " /* offset #{offset} */")
+	@decomp_expansions_offset += decomp.size
       end
     end
     offset
   end
 
-  def print_composition_table(data, outfile = 'compose.h')
-    first = Hash.new(0)
-    second = Hash.new(0)
+  # Composition pairs are kept in a table built with the hash and displace
+  # method, so that combining two characters only ever looks at one slot.
+  # A pair is first hashed to a bucket, whose displacement is then mixed into
+  # a second hash of the pair that gives its slot.  Buckets are placed
+  # largest first, each with the smallest displacement that puts all of its
+  # pairs in free slots.  These functions must match COMPOSE_PAIR_KEY,
+  # COMPOSE_PAIR_BUCKET, and COMPOSE_PAIR_SLOT in the generated header.
+  def compose_pair_key(first, second)
+    (first << 16) | second
+  end
+
+  def compose_pair_bucket(key, bits)
+    ((key * 0x9e3779b1) & 0xffffffff) >> (32 - bits)
+  end
 
+  def compose_pair_slot(key, displacement, bits)
+    mixed = key ^ ((displacement * 0x9e3779b9) & 0xffffffff)
+    ((mixed * 0x85ebca6b) & 0xffffffff) >> (32 - bits)
+  end
+
+  def print_composition_table(data, outfile = 'compose.h')
+    pairs = []
     data.compositions.each do |code, value|
       values = value.split(/\s+/).map{ |s| s.to_i(16) }
 
       # skip non-starters and single-character decompositions
-      if data.cclass[values[0]] != '0' or values.size == 1
-	data.compositions.delete(code)
-	next
-      end
+      next if data.cclass[values[0]] != '0' or values.size == 1
 
       if values.size != 2
 	error("decomposition of entry contains more than two elements:\n" +
@@ -826,74 +1194,47 @@ EOL
 	      code, values.size)
       end
 
-      first[values[0]] += 1
-    end
-    
-    n_first = first.enumerate_ordered
-
-    data.compositions.each do |code, value|
-      values = value.split(/\s+/).map{ |s| s.to_i(16) }
+      if code > 0xffff or values[0] > 0xffff or values[1] > 0xffff
+	error("compose_pairs table field too short." +
+	      "  Upgrade to unichar to fit values beyond 0xffff.")
+      end
 
-      second[values[1]] += 1 if first.member?(values[0])
+      pairs.push([values[0], values[1], code])
     end
 
-    n_second = second.enumerate_ordered
+    slot_bits = 1
+    slot_bits += 1 while (1 << slot_bits) < 2 * pairs.size
+    bucket_bits = slot_bits - 2
 
-    first_singletons = []
-    second_singletons = []
-    reverse = {}
-    data.compositions.each do |code, value|
-      values = value.split(/\s+/).map{ |s| s.to_i(16) }
+    buckets = Array.new(1 << bucket_bits){ [] }
+    pairs.each do |pair|
+      key = compose_pair_key(pair[0], pair[1])
+      buckets[compose_pair_bucket(key, bucket_bits)].push(pair)
+    end
 
-      if first.member?(values[0]) and second.member?(values[1])
-	reverse["#{first[values[0]]}|#{second[values[1]]}"] = code
-      elsif not first.member?(values[0])
-	first_singletons.push([values[0], values[1], code])
-      else
-	second_singletons.push([values[1], values[0], code])
+    slots = Array.new(1 << slot_bits)
+    displacements = Array.new(1 << bucket_bits, 0)
+    order = (0...buckets.size).sort_by{ |i| [-buckets[i].size, i] }
+    order.each do |i|
+      keys = buckets[i].map{ |pair| compose_pair_key(pair[0], pair[1]) }
+      next if keys.empty?
+      displacement = (0..0xffff).find do |d|
+	taken = keys.map{ |key| compose_pair_slot(key, d, slot_bits) }
+	taken.uniq.size == taken.size and taken.all?{ |slot| slots[slot].nil? }
+      end
+      if displacement.nil?
+	error("couldn't find a displacement for compose_pairs bucket %d", i)
+      end
+      displacements[i] = displacement
+      buckets[i].each_with_index do |pair, j|
+	slots[compose_pair_slot(keys[j], displacement, slot_bits)] = pair
       end
     end
 
-    first_singletons = first_singletons.sort_by{ |a| a[0] }
-    second_singletons = second_singletons.sort_by{ |a| a[0] }
-
-    row = []
     saved_stdout = $stdout
     File.open(outfile, 'w') do |file|
       header_h = outfile.upcase.gsub(/[^A-Z0-9]/, '_')
       $stdout = file
-      values = {}
-      total = first_start = 1
-      last = 0
-
-      first.each do |code, value|
-	values[code] = value + total
-	last = code if code > last
-      end
-      total += n_first
-
-      first_single_start = total
-      first_singletons.each_with_index do |item, i|
-	code = item[0]
-	values[code] = i + total
-	last = code if code > last
-      end
-      total += first_singletons.size
-
-      second_start = total
-      second.each do |code, value|
-	values[code] = value + total
-	last = code if code > last
-      end
-      total += n_second
-
-      second_single_start = total
-      second_singletons.each_with_index do |item, i|
-	code = item[0]
-	values[code] = i + total
-	last = code if code > last
-      end
-
       print <<EOL
 /* Automatically generated file */
 
@@ -901,81 +1242,43 @@ EOL
 #define #{header_h}
 
 
-#define COMPOSE_FIRST_START #{first_start}
-#define COMPOSE_FIRST_SINGLE_START #{first_single_start}
-#define COMPOSE_SECOND_START #{second_start}
-#define COMPOSE_SECOND_SINGLE_START #{second_single_start}
-#define COMPOSE_TABLE_LAST #{last / 256}
-EOL
-
-      print_table(data, 0, last, last, 2,
-		  <<EOH, <<EOH1, nil){ |i| values.member?(i) ? values[i].to_s : '0' }
-
-
-static const uint16_t compose_data[][256] = {
-EOH
-
+#define COMPOSE_PAIR_BUCKET_BITS #{bucket_bits}
+#define COMPOSE_PAIR_SLOT_BITS #{slot_bits}
 
-static const int16_t compose_table[COMPOSE_TABLE_LAST + 1] = {
-EOH1
-
-      print <<EOL
+#define COMPOSE_PAIR_KEY(first, second) \\
+	(((uint32_t)(first) << 16) | (uint32_t)(second))
+#define COMPOSE_PAIR_BUCKET(key) \\
+	((uint32_t)((key) * UINT32_C(0x9e3779b1)) >> \\
+	 (32 - COMPOSE_PAIR_BUCKET_BITS))
+#define COMPOSE_PAIR_SLOT(key, displacement) \\
+	((uint32_t)(((key) ^ (uint32_t)((displacement) * UINT32_C(0x9e3779b9))) * \\
+		    UINT32_C(0x85ebca6b)) >> (32 - COMPOSE_PAIR_SLOT_BITS))
 
 
-static const uint16_t compose_first_single[][2] = {
+static const uint16_t compose_pair_displacements[1 << COMPOSE_PAIR_BUCKET_BITS] = {
 EOL
-      first_singletons.each_with_index do |item, i|
-	if item[1] > 0xffff or item[2] > 0xffff
-	  error("compose_first_single table field too short." +
-		"  Upgrade to unichar to fit values beyond 0xffff.")
-	end
-	printf("%s{ %#06x, %#06x },\n", data.indent, item[1], item[2])
+      displacements.each_with_index do |displacement, i|
+	print(data.indent) if i % 8 == 0
+	printf("%5d,", displacement)
+	print(i % 8 == 7 ? "\n" : " ")
       end
-      print("};\n")
-
-      print <<EOL
-
-
-static const uint16_t compose_second_single[][2] = {
-EOL
-      second_singletons.each_with_index do |item, i|
-	if item[1] > 0xffff or item[2] > 0xffff
-	  error("compose_second_single table field too short." +
-		"  Upgrade to unichar to fit values beyond 0xffff.")
-	end
-	printf("%s{ %#06x, %#06x },\n", data.indent, item[1], item[2])
-      end
-      print("};\n")
-
+      print("\n") if displacements.size % 8 != 0
       print <<EOL
+};
 
 
-static const uint16_t compose_array[#{n_first}][#{n_second}] = {
+static const uint16_t compose_pairs[1 << COMPOSE_PAIR_SLOT_BITS][3] = {
 EOL
-      0.upto(n_first - 1) do |i|
-	printf("%s{\n%s", data.indent, data.indent * 2)
-	column = data.indent.width * 2
-	0.upto(n_second - 1) do |j|
-	  if column + 8 > 79
-	    printf("\n%s", data.indent * 2)
-	    column = data.indent.width * 2
-	  end
-	  if reverse.member?("#{i}|#{j}")
-	    if reverse["#{i}|#{j}"] > 0xffff
-	      error("compose_array table field too short." +
-		    "  Upgrade to unichar to fit values beyond 0xffff.")
-	    end
-	    printf("0x%04x, ", reverse["#{i}|#{j}"])
-	  else
-	    print("     0, ")
-	  end
-	  column += 8
+      # combine() tells empty slots apart by their result of 0.
+      slots.each do |pair|
+	if pair.nil?
+	  printf("%s{ 0, 0, 0 },\n", data.indent)
+	else
+	  printf("%s{ %#06x, %#06x, %#06x },\n", data.indent, *pair)
 	end
-	printf("\n%s},\n", data.indent)
       end
-      print("};\n")
-
       print <<EOL
+};
 
 
 #endif /* #{header_h} */
@@ -1032,6 +1335,278 @@ EOH2
       print <<EOF
 
 
+#endif /* #{header_h} */
+EOF
+    end
+    $stdout = saved_stdout
+  end
+
+  # A collation element is packed into 32 bits: the primary weight in bits
+  # 16-31, the secondary weight in bits 7-15, the tertiary weight in bits 2-6,
+  # and whether it is variable in bit 0.  This must match the
+  # COLLATION_ELEMENT_* macros in the generated header.
+  def pack_collation_element(element)
+    primary, secondary, tertiary, variable = element
+    if secondary > 0x1ff or tertiary > 0x1f
+      error("collation element weights too large to pack:\n" +
+	    "    secondary: %04X\n" +
+	    "    tertiary: %04X\n",
+	    secondary, tertiary)
+    end
+    (primary << 16) | (secondary << 7) | (tertiary << 2) | (variable ? 1 : 0)
+  end
+
+  def handle_collation_elements(elements, offsets, pool)
+    packed = elements.map{ |element| pack_collation_element(element) }
+    return offsets[packed] if offsets.include? packed
+    offsets[packed] = pool.size
+    pool.concat(packed)
+    if pool.size > 0xffff
+      error('collation_elements offset too large for collate_table.' +
+	    '  Upgrade offsets to uint32_t.')
+    end
+    offsets[packed]
+  end
+
+  # Entries for characters that have a canonical decomposition, and
+  # contractions that contain such characters, are left out, as collation
+  # works on strings in NFD.
+  def collation_entries(data)
+    singles = {}
+    contractions = {}
+    data.collation_elements.each do |codes, elements|
+      next if codes.any?{ |code| data.decompositions[code] and
+				 not data.decompose_compat[code] }
+      if codes.size == 1
+	singles[codes[0]] = elements
+      else
+	(contractions[codes[0]] ||= []).push(codes)
+      end
+    end
+    [singles, contractions]
+  end
+
+  # Assigned characters in the ranges given by @implicitweights get implicit
+  # weights with the base of their range.  The second weight counts from the
+  # first character of all the ranges with that base, as Tangut and the
+  # Tangut Supplement share theirs.  Unassigned characters are left out, so
+  # that they get the weights of other unassigned characters.
+  def implicit_weight_ranges(data)
+    offsets = {}
+    data.implicit_weights.each do |first, last, base|
+      offsets[base] = first if offsets[base].nil? or first < offsets[base]
+    end
+    ranges = []
+    data.implicit_weights.sort.each do |first, last, base|
+      first.upto(last) do |code|
+	next if data.type[code].nil? or data.type[code] == 'Cn'
+	if ranges.last and ranges.last[1] + 1 == code and ranges.last[2] == base
+	  ranges.last[1] = code
+	else
+	  ranges.push([code, code, base, offsets[base]])
+	end
+      end
+    end
+    ranges
+  end
+
+  # Unified ideographs in the core blocks get implicit weights with a base of
+  # FB40 and the rest with a base of FB80.  Adjacent ranges with the same base
+  # are merged.
+  def unified_ideograph_ranges(data)
+    ranges = []
+    data.unified_ideographs.sort.each do |first, last|
+      block = data.core_ideograph_blocks.find do |block_first, block_last|
+	first <= block_last and last >= block_first
+      end
+      if block and (first < block[0] or last > block[1])
+	error("unified ideographs %04X..%04X straddle a block boundary",
+	      first, last)
+      end
+      base = block ? 0xfb40 : 0xfb80
+      if ranges.last and ranges.last[1] + 1 == first and ranges.last[2] == base
+	ranges.last[1] = last
+      else
+	ranges.push([first, last, base])
+      end
+    end
+    ranges
+  end
+
+  def print_collation(data, outfile = 'collate.h')
+    singles, contractions = collation_entries(data)
+    codes = (singles.keys | contractions.keys).sort
+    max_contraction_length = 1
+    max_contractions = 0
+    max_elements = 0
+    contractions.each do |code, sequences|
+      sequences.each do |sequence|
+	max_contraction_length = [max_contraction_length, sequence.size].max
+      end
+      max_contractions = [max_contractions, sequences.size].max
+    end
+    data.collation_elements.each_value do |elements|
+      max_elements = [max_elements, elements.size].max
+    end
+    if max_contractions > 0xff or max_elements > 0xff
+      error('collate_table field too short.  Upgrade to uint16_t.')
+    end
+
+    saved_stdout = $stdout
+    File.open(outfile, 'w') do |file|
+      header_h = outfile.upcase.gsub(/[^A-Z0-9]/, '_')
+      $stdout = file
+      print <<EOF
+/* Automatically generated file */
+
+#ifndef #{header_h}
+#define #{header_h}
+
+
+#define UNICODE_COLLATION_VERSION "#{data.collation_version}"
+
+#define UNICODE_MAX_TABLE_INDEX (0x110000 / 256)
+
+#define COLLATE_MAX_CONTRACTION_LENGTH #{max_contraction_length}
+
+#define COLLATE_MAX_ELEMENTS #{max_elements}
+
+/*
+ * A collation element keeps its primary weight in bits 16-31, its secondary
+ * weight in bits 7-15, its tertiary weight in bits 2-6, and whether it is
+ * variable in bit 0.
+ */
+#define COLLATION_ELEMENT(primary, secondary, tertiary) \\
+	(((uint32_t)(primary) << 16) | ((uint32_t)(secondary) << 7) | \\
+	 ((uint32_t)(tertiary) << 2))
+#define COLLATION_ELEMENT_PRIMARY(element) \\
+	((uint16_t)((element) >> 16))
+#define COLLATION_ELEMENT_SECONDARY(element) \\
+	((uint16_t)(((element) >> 7) & 0x1ff))
+#define COLLATION_ELEMENT_TERTIARY(element) \\
+	((uint16_t)(((element) >> 2) & 0x1f))
+#define COLLATION_ELEMENT_IS_VARIABLE(element) \\
+	(((element) & 1) != 0)
+
+
+/*
+ * The collation elements of each character that has an entry in the DUCET,
+ * or that begins a contraction, as offsets into and lengths in
+ * collation_elements.  Characters that begin a contraction also have the
+ * index and number of their contractions in collate_contractions.  A
+ * character without collation elements of its own has length 0.  Entries are
+ * ordered by character and are found through collate_index_table.
+ */
+static const struct {
+#{data.indent}uint16_t offset;
+#{data.indent}uint8_t length;
+#{data.indent}uint8_t n_contractions;
+#{data.indent}uint16_t contractions;
+} collate_table[] = {
+EOF
+      offsets = {}
+      pool = []
+      sequences = []
+      codes.each do |code|
+	elements = singles[code]
+	offset = elements.nil? ? 0 :
+	  handle_collation_elements(elements, offsets, pool)
+	first = sequences.size
+	(contractions[code] || []).sort_by{ |s| [-s.size, s] }.each do |s|
+	  sequences.push(s)
+	end
+	if sequences.size > 0xffff
+	  error('collate_table contractions field too short.')
+	end
+	printf("%s{ %d, %d, %d, %d }, /* 0x%04x */\n",
+	       data.indent, offset, elements.nil? ? 0 : elements.size,
+	       sequences.size - first, first, code)
+      end
+      print("\n};")
+
+      print_index_table(data, 'collate', codes)
+
+      print <<EOF
+
+
+/*
+ * Contractions, longest first for each character that begins any, with the
+ * offsets into and lengths in collation_elements of their collation
+ * elements.
+ */
+static const struct {
+#{data.indent}unichar chars[COLLATE_MAX_CONTRACTION_LENGTH];
+#{data.indent}uint8_t n_chars;
+#{data.indent}uint8_t length;
+#{data.indent}uint16_t offset;
+} collate_contractions[] = {
+EOF
+      sequences.each do |sequence|
+	elements = data.collation_elements[sequence]
+	offset = handle_collation_elements(elements, offsets, pool)
+	chars = sequence + [0] * (max_contraction_length - sequence.size)
+	printf("%s{ { %s }, %d, %d, %d },\n", data.indent,
+	       chars.map{ |c| sprintf('0x%04x', c) }.join(', '),
+	       sequence.size, elements.size, offset)
+      end
+      print <<EOF
+};
+
+
+/*
+ * Ranges of assigned characters that are given implicit weights with a base
+ * of their own, with the first primary weight of each range and the
+ * character that the second primary weight is counted from.
+ */
+static const struct {
+#{data.indent}unichar first;
+#{data.indent}unichar last;
+#{data.indent}uint16_t base;
+#{data.indent}unichar offset;
+} collate_implicit_weights[] = {
+EOF
+      implicit_weight_ranges(data).each do |first, last, base, offset|
+	printf("%s{ 0x%04x, 0x%04x, 0x%04x, 0x%04x },\n",
+	       data.indent, first, last, base, offset)
+      end
+      print <<EOF
+};
+
+
+/*
+ * Ranges of unified ideographs, which are given implicit weights with a base
+ * that depends on whether they're in the CJK Unified Ideographs or CJK
+ * Compatibility Ideographs blocks or not.
+ */
+static const struct {
+#{data.indent}unichar first;
+#{data.indent}unichar last;
+#{data.indent}uint16_t base;
+} collate_unified_ideographs[] = {
+EOF
+      unified_ideograph_ranges(data).each do |first, last, base|
+	printf("%s{ 0x%04x, 0x%04x, 0x%04x },\n", data.indent, first, last, base)
+      end
+      print <<EOF
+};
+
+
+/*
+ * The collation elements referred to by collate_table and
+ * collate_contractions.
+ */
+static const uint32_t collation_elements[] = {
+EOF
+      pool.each_with_index do |element, i|
+	print(data.indent) if i % 6 == 0
+	printf("0x%08x,", element)
+	print(i % 6 == 5 ? "\n" : " ")
+      end
+      print("\n") if pool.size % 6 != 0
+      print <<EOF
+};
+
+
 #endif /* #{header_h} */
 EOF
     end
@@ -1046,7 +1621,8 @@ class Runner
     check_for_data_files(ARGV[1])
     data = CollectedData.new(ARGV[1], "\t")
     [CompositionExclusions, UnicodeData, LineBreak,
-      SpecialCasing, CaseFolding, BidiMirroring, Printer].each do |klass|
+      SpecialCasing, CaseFolding, BidiMirroring, DerivedCoreProperties,
+      PropList, Blocks, Collation, Printer].each do |klass|
       klass.new.process(data)
     end
   end
@@ -1054,7 +1630,9 @@ class Runner
 private
   def check_for_data_files(dir)
     ['UnicodeData.txt', 'LineBreak.txt', 'SpecialCasing.txt', 'CaseFolding.txt',
-      'CompositionExclusions.txt', 'BidiMirroring.txt'].each do |file|
+      'CompositionExclusions.txt', 'BidiMirroring.txt',
+      'DerivedCoreProperties.txt', 'PropList.txt', 'Blocks.txt',
+      'allkeys.txt'].each do |file|
       path = File.join(dir, file)
       unless File.readable?(path)
 	error('missing required file: %s', path)
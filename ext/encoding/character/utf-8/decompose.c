@@ -4,10 +4,22 @@
  * Copyright (C) 2004 Nikolai Weibull <source@pcppopper.org>
  */
 
+#ifdef HAVE_PTHREAD_H
+/* We’re compiled with -std=c99, which hides pthread_sigmask() and friends. */
+#  define _XOPEN_SOURCE 600
+#endif
+
 #include <ruby.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
+#ifdef HAVE_PTHREAD_H
+#  include <pthread.h>
+#  include <setjmp.h>
+#  include <signal.h>
+#  include <unistd.h>
+#endif
 
 #include "unicode.h"
 
@@ -19,6 +31,63 @@
 #define COMBINING_CLASS(c)      \
         SPLIT_UNICODE_TABLE_LOOKUP(cclass_data, combining_class_table_part1, combining_class_table_part2, (c), 0)
 
+#define QUICK_CHECK(c)          \
+        UNICODE_TABLE_INDEX_LOOKUP(quick_check_data, quick_check_table, (c))
+
+
+/* {{{1
+ * Buffers that are used while normalizing are allocated with
+ * NORMALIZE_ALLOC_N() and NORMALIZE_REALLOC_N(), as utf_normalize_impl() may
+ * fill them on worker threads.  These mustn’t call into Ruby, as xmalloc()
+ * may start a garbage collection or raise NoMemError, so under
+ * normalize_guard() they use realloc() instead and jump back to it if it
+ * fails.
+ */
+#ifdef HAVE_PTHREAD_H
+__thread NormalizeWorker *normalize_worker;
+
+/* {{{1
+ * Call ‘f’ with ‘closure’, returning false if it ran out of memory.  ‘f’ must
+ * not call into Ruby.  Only the scratch buffer of ‘f’ is freed for it, as
+ * its frames are gone by the time that we get back here, so ‘f’ must keep
+ * anything else that it allocates where the caller can free it, as
+ * unicode_canonical_ordering() and CollateSortJob do.
+ */
+bool
+normalize_guard(void (*f)(void *), void *closure)
+{
+        NormalizeWorker worker;
+
+        worker.scratch = NULL;
+        normalize_worker = &worker;
+        if (setjmp(worker.out_of_memory) != 0) {
+                free(worker.scratch);
+                normalize_worker = NULL;
+                return false;
+        }
+
+        f(closure);
+        normalize_worker = NULL;
+
+        return true;
+}
+#endif
+
+void *
+normalize_realloc(void *p, size_t size)
+{
+#ifdef HAVE_PTHREAD_H
+        if (normalize_worker != NULL) {
+                void *q = realloc(p, size);
+                if (q == NULL)
+                        longjmp(normalize_worker->out_of_memory, 1);
+                return q;
+        }
+#endif
+
+        return xrealloc(p, size);
+}
+
 
 /* {{{1
  * Hangul syllable [de]composition constants. A lot of work I'd say.
@@ -48,48 +117,101 @@ unichar_combining_class(unichar c)
 
 
 /* {{{1
- * Rearrange ‘str’ so that decomposed characters are arranged according to
- * their combining class.  Do this for at most ‘len’ bytes of data.
+ * Sort the ‘len’ non-starters in ‘str’, whose combining classes are in
+ * ‘classes’, by combining class, keeping characters of equal class in
+ * order.  Short runs, which is what all real text has, are insertion sorted.
+ * Longer ones are counting sorted, so that a string with thousands of
+ * combining marks on one character doesn’t take quadratic time.
  */
+#define CANONICAL_ORDERING_INSERTION_SORT_MAX 32
+
 static void
-unicode_canonical_ordering_swap(unichar *str, size_t offset, int next, bool *swapped)
+unicode_canonical_ordering_sort(unichar *str, uint8_t *classes, size_t len)
 {
-        size_t initial = offset + 1;
+        if (len <= CANONICAL_ORDERING_INSERTION_SORT_MAX) {
+                for (size_t i = 1; i < len; i++) {
+                        unichar c = str[i];
+                        uint8_t cc = classes[i];
+
+                        size_t j = i;
+                        while (j > 0 && classes[j - 1] > cc) {
+                                str[j] = str[j - 1];
+                                classes[j] = classes[j - 1];
+                                j--;
+                        }
+                        str[j] = c;
+                        classes[j] = cc;
+                }
+                return;
+        }
 
-        size_t j = initial;
-        while (j > 0 && COMBINING_CLASS(str[j - 1]) > next) {
-                unichar c = str[j];
-                str[j] = str[j - 1];
-                str[j - 1] = c;
-                j--;
+        size_t offsets[UINT8_MAX + 1] = { 0 };
+        for (size_t i = 0; i < len; i++)
+                offsets[classes[i]]++;
+        size_t offset = 0;
+        for (size_t i = 0; i <= UINT8_MAX; i++) {
+                size_t n = offsets[i];
+                offsets[i] = offset;
+                offset += n;
         }
 
-        *swapped = *swapped || (j != initial);
+        unichar *sorted = NORMALIZE_ALLOC_N(unichar, len);
+        for (size_t i = 0; i < len; i++)
+                sorted[offsets[classes[i]]++] = str[i];
+        memcpy(str, sorted, len * sizeof(unichar));
+        free(sorted);
 }
 
-static bool
-unicode_canonical_ordering_reorder(unichar *str, size_t len)
+
+/* {{{1
+ * Rearrange ‘str’ so that decomposed characters are arranged according to
+ * their combining class.  Do this for at most ‘len’ characters of data.
+ * Each run of non-starters is sorted on its own, as starters never move.
+ * We look up the combining class of each character once, keeping them in
+ * ‘classes’, and only sort runs that are out of order.
+ */
+void
+unicode_canonical_ordering(unichar *str, size_t len)
 {
-        bool swapped = false;
+        uint8_t inline_classes[CANONICAL_ORDERING_INSERTION_SORT_MAX];
+        uint8_t *classes = inline_classes;
+        size_t capacity = lengthof(inline_classes);
 
-        int prev = COMBINING_CLASS(str[0]);
-        for (size_t i = 0; i < len - 1; i++) {
-                int next = COMBINING_CLASS(str[i + 1]);
+        size_t n = 0;
+        bool sorted = true;
+        for (size_t i = 0; i <= len; i++) {
+                int cc = (i < len) ? COMBINING_CLASS(str[i]) : 0;
+
+                if (cc == 0) {
+                        if (!sorted)
+                                unicode_canonical_ordering_sort(str + i - n,
+                                                                classes, n);
+                        n = 0;
+                        sorted = true;
+                        continue;
+                }
 
-                if (next != 0 && prev > next)
-                        unicode_canonical_ordering_swap(str, i, next, &swapped);
-                else
-                        prev = next;
-        }
+                if (n == capacity) {
+                        capacity *= 2;
+                        if (classes == inline_classes) {
+                                classes = NORMALIZE_ALLOC_N(uint8_t, capacity);
+                                memcpy(classes, inline_classes,
+                                       sizeof(inline_classes));
+                        } else {
+                                NORMALIZE_REALLOC_N(classes, uint8_t, capacity);
+                        }
+                        NORMALIZE_SCRATCH(classes);
+                }
 
-        return swapped;
-}
+                if (n > 0 && classes[n - 1] > cc)
+                        sorted = false;
+                classes[n++] = cc;
+        }
 
-void
-unicode_canonical_ordering(unichar *str, size_t len)
-{
-        while (unicode_canonical_ordering_reorder(str, len))
-                ; /* This loop intentionally left empty. */
+        if (classes != inline_classes) {
+                NORMALIZE_SCRATCH(NULL);
+                free(classes);
+        }
 }
 
 
@@ -133,52 +255,50 @@ decompose_hangul(unichar s, unichar *r)
 /* {{{1
  * Search the Unicode decomposition table for ‘c’ and depending on the boolean
  * value of ‘compat’, return its compatibility or canonical decomposition if
- * found.
+ * found.  The length of the decomposition is stored in ‘len’.
  */
-static const char *
-get_decomposition(int index, bool compat)
+static const unichar *
+find_decomposition(unichar c, bool compat, size_t *len)
 {
-        int offset;
+        int index;
+
+        if (!unicode_table_lookup(decomp, c, &index))
+                return NULL;
 
-        if (compat) {
+        int offset;
+        if (compat && decomp_table[index].compat_length > 0) {
                 offset = decomp_table[index].compat_offset;
-                if (offset == UNICODE_NOT_PRESENT_OFFSET)
-                        offset = decomp_table[index].canon_offset;
-                /* Either .compat_offset or .canon_offset can be missing, but
-                 * not both. */
+                *len = decomp_table[index].compat_length;
         } else {
-                offset = decomp_table[index].canon_offset;
-                if (offset == UNICODE_NOT_PRESENT_OFFSET)
+                /* Either the compatibility or the canonical decomposition
+                 * can be missing, but not both. */
+                if (decomp_table[index].canon_length == 0)
                         return NULL;
+                offset = decomp_table[index].canon_offset;
+                *len = decomp_table[index].canon_length;
         }
 
-        return &decomp_expansion_string[offset];
+        return &decomp_expansions[offset];
 }
 
-static const char *
-find_decomposition(unichar c, bool compat)
+
+/* {{{1
+ * Search the NFKC_Casefold table for ‘c’, which mustn’t have a canonical
+ * decomposition, and return its mapping, or NULL if it maps to itself.  The
+ * length of the mapping, which is 0 for default ignorable code points, is
+ * stored in ‘len’.
+ */
+static const unichar *
+find_nfkc_casefold(unichar c, size_t *len)
 {
         int index;
 
-        if (!unicode_table_lookup(decomp_table, c, &index))
+        if (!unicode_table_lookup(nfkc_casefold, c, &index))
                 return NULL;
 
-        return get_decomposition(index, compat);
-}
-
+        *len = nfkc_casefold_table[index].length;
 
-/* {{{1
- * Copy over the UTF-8 decomposition in ‘decomposition’ to the unichar buffer
- * ‘chars’.  Return the number of unichars in ‘chars’.
- */
-static size_t
-decomposition_to_wc(const char *decomposition, unichar *chars)
-{
-        size_t i = 0;
-        for (const char *p = decomposition; *p != '\0'; p = utf_next(p))
-                chars[i++] = utf_char(p);
-
-        return i;
+        return &decomp_expansions[nfkc_casefold_table[index].offset];
 }
 
 
@@ -190,7 +310,7 @@ decomposition_to_wc(const char *decomposition, unichar *chars)
 unichar *
 unicode_canonical_decomposition(unichar c, size_t *len)
 {
-        const char *decomp;
+        const unichar *decomp;
         unichar *r;
 
         /* Hangul syllable */
@@ -198,10 +318,9 @@ unicode_canonical_decomposition(unichar c, size_t *len)
                 *len = decompose_hangul(c, NULL);
                 r = ALLOC_N(unichar, *len);
                 decompose_hangul(c, r);
-        } else if ((decomp = find_decomposition(c, false)) != NULL) {
-                *len = utf_length(decomp);
+        } else if ((decomp = find_decomposition(c, false, len)) != NULL) {
                 r = ALLOC_N(unichar, *len);
-                decomposition_to_wc(decomp, r);
+                memcpy(r, decomp, *len * sizeof(unichar));
         } else {
                 r = ALLOC(unichar);
                 *r = c;
@@ -247,166 +366,843 @@ combine_hangul(unichar a, unichar b, unichar *result)
 
 /* {{{1
  * Try to combine the Unicode characters ‘a’ and ‘b’ storing the result in
- * ‘result’.
+ * ‘result’.  Apart from Hangul, which combines algorithmically, the pair is
+ * looked up in compose_pairs, where it can only be in the one slot that its
+ * bucket’s displacement sends it to.  Empty slots are all zeros, so a slot
+ * whose result is 0, which no pair composes to, doesn’t match anything.
  */
-static uint16_t
-compose_index(unichar c)
+static bool
+combine(unichar a, unichar b, unichar *result)
 {
-        unsigned int page = c >> 8;
-
-        if (page > COMPOSE_TABLE_LAST)
-                return 0;
+        if (combine_hangul(a, b, result))
+                return true;
 
-        return SPLIT_UNICODE_TABLE_LOOKUP_PAGE(compose_data, compose_table, page, c);
-}
+        if (a > 0xffff || b > 0xffff)
+                return false;
 
-static bool
-lookup_compose(const uint16_t table[][2], uint16_t index, unichar c,
-               unichar *result)
-{
-        if (c != table[index][0])
+        uint32_t key = COMPOSE_PAIR_KEY(a, b);
+        uint16_t displacement =
+                compose_pair_displacements[COMPOSE_PAIR_BUCKET(key)];
+        const uint16_t *pair = compose_pairs[COMPOSE_PAIR_SLOT(key, displacement)];
+        if (pair[0] != a || pair[1] != b || pair[2] == 0)
                 return false;
 
-        *result = table[index][1];
+        *result = pair[2];
 
         return true;
 }
 
-static bool
-combine(unichar a, unichar b, unichar *result)
+
+/* {{{1
+ * A growable buffer of unichars that doesn’t allocate anything until it grows
+ * beyond its inline storage.
+ */
+void
+unichar_buffer_init(UnicharBuffer *buffer)
 {
-        if (combine_hangul(a, b, result))
-                return true;
+        buffer->chars = buffer->inline_chars;
+        buffer->len = 0;
+        buffer->capacity = lengthof(buffer->inline_chars);
+}
 
-        uint16_t index_a = compose_index(a);
-        if (index_a >= COMPOSE_FIRST_SINGLE_START && index_a < COMPOSE_SECOND_START)
-                return lookup_compose(compose_first_single,
-                                      index_a - COMPOSE_FIRST_SINGLE_START,
-                                      b,
-                                      result);
-
-        uint16_t index_b = compose_index(b);
-        if (index_b >= COMPOSE_SECOND_SINGLE_START)
-                return lookup_compose(compose_second_single,
-                                      index_b - COMPOSE_SECOND_SINGLE_START,
-                                      a,
-                                      result);
-
-        if (index_a >= COMPOSE_FIRST_START &&
-            index_a < COMPOSE_FIRST_SINGLE_START &&
-            index_b >= COMPOSE_SECOND_START &&
-            index_b < COMPOSE_SECOND_SINGLE_START) {
-                unichar r = compose_array[index_a - COMPOSE_FIRST_START][index_b - COMPOSE_SECOND_START];
-
-                if (r != 0) {
-                        *result = r;
-                        return true;
+void
+unichar_buffer_append(UnicharBuffer *buffer, unichar c)
+{
+        if (buffer->len == buffer->capacity) {
+                buffer->capacity *= 2;
+                if (buffer->chars == buffer->inline_chars) {
+                        buffer->chars = NORMALIZE_ALLOC_N(unichar,
+                                                          buffer->capacity);
+                        memcpy(buffer->chars, buffer->inline_chars,
+                               sizeof(buffer->inline_chars));
+                } else {
+                        NORMALIZE_REALLOC_N(buffer->chars, unichar,
+                                            buffer->capacity);
                 }
         }
 
-        return false;
+        buffer->chars[buffer->len++] = c;
+}
+
+void
+unichar_buffer_free(UnicharBuffer *buffer)
+{
+        if (buffer->chars != buffer->inline_chars)
+                free(buffer->chars);
+
+        unichar_buffer_init(buffer);
 }
 
 
 /* {{{1
- * Normalize (compose/decompose) characters in ‘str’ so that strings that
- * actually contain the same characters will be recognized as equal for
- * comparison for example.
+ * Normalize a string without materializing the result, handing each
+ * character of the normalized string to a sink as soon as it is known.
+ *
+ * Characters are decomposed into ‘decomposed’, which holds the current
+ * segment, that is, a starter and the non-starters that follow it.  When the
+ * next starter arrives, the segment is put in canonical order and passed on.
+ * If we’re applying NFKC_Casefold, the characters of the segment are then
+ * mapped and decomposed once more into ‘folded’, as the mappings aren’t in
+ * canonical order and may begin with non-starters.  Finally, if we’re
+ * composing, ‘composed’ holds the last starter and any non-starters that
+ * didn’t combine with it, as the starter may still combine with characters
+ * that follow.
  */
-static size_t
-normalize_wc_decompose_one(unichar c, NormalizeMode mode, unichar *buf)
+static void compose_add(NormalizeStream *stream, unichar c);
+
+static void
+segment_add(NormalizeStream *stream, UnicharBuffer *segment, unichar c,
+            void (*flush)(NormalizeStream *))
 {
-        bool do_compat = (mode == NORMALIZE_NFKC || mode == NORMALIZE_NFKD);
-        const char *decomp = find_decomposition(c, do_compat);
+        if (segment->len > 0 && COMBINING_CLASS(c) == 0)
+                flush(stream);
 
+        unichar_buffer_append(segment, c);
+}
+
+static void
+decompose_into(NormalizeStream *stream, unichar c, UnicharBuffer *segment,
+               void (*flush)(NormalizeStream *))
+{
+        if (c >= SBase && c <= SLast) {
+                unichar hangul[3];
+                size_t n = decompose_hangul(c, hangul);
+                for (size_t i = 0; i < n; i++)
+                        segment_add(stream, segment, hangul[i], flush);
+                return;
+        }
+
+        size_t len;
+        const unichar *decomp = find_decomposition(c, stream->compat, &len);
         if (decomp == NULL) {
-                if (buf != NULL)
-                        buf[0] = c;
-                return 1;
+                segment_add(stream, segment, c, flush);
+                return;
         }
 
-        if (buf != NULL)
-                return decomposition_to_wc(decomp, buf);
+        for (size_t i = 0; i < len; i++)
+                segment_add(stream, segment, decomp[i], flush);
+}
+
+static void
+flush_folded(NormalizeStream *stream)
+{
+        UnicharBuffer *segment = &stream->folded;
+
+        if (segment->len > 1)
+                unicode_canonical_ordering(segment->chars, segment->len);
+        for (size_t i = 0; i < segment->len; i++)
+                compose_add(stream, segment->chars[i]);
 
-        return utf_length(decomp);
+        segment->len = 0;
 }
 
 static void
-normalize_wc_decompose(const char *str, size_t max_len, bool use_len,
-                       NormalizeMode mode, unichar *buf, size_t *buf_len)
+flush_decomposed(NormalizeStream *stream)
 {
-        size_t n = 0;
-        size_t prev_start = 0;
-        const char *end = str + max_len;
-        for (const char *p = str; (!use_len || p < end) && *p != NUL; p = utf_next(p)) {
-                unichar c = utf_char(p);
-                size_t prev_n = n;
-
-                unichar *base = (buf != NULL) ? buf + n : NULL;
-                if (c >= SBase && c <= SLast)
-                        n += decompose_hangul(c, base);
-                else
-                        n += normalize_wc_decompose_one(c, mode, base);
-
-                if (buf != NULL && n > 0 && COMBINING_CLASS(buf[prev_n]) == 0) {
-                        unicode_canonical_ordering(buf + prev_start,
-                                                   n - prev_start);
-                        prev_start = prev_n;
+        UnicharBuffer *segment = &stream->decomposed;
+
+        if (segment->len > 1)
+                unicode_canonical_ordering(segment->chars, segment->len);
+        for (size_t i = 0; i < segment->len; i++) {
+                if (!stream->fold) {
+                        compose_add(stream, segment->chars[i]);
+                        continue;
+                }
+
+                size_t n;
+                const unichar *mapping = find_nfkc_casefold(segment->chars[i],
+                                                            &n);
+                if (mapping == NULL) {
+                        segment_add(stream, &stream->folded, segment->chars[i],
+                                    flush_folded);
+                        continue;
                 }
+
+                for (size_t j = 0; j < n; j++)
+                        decompose_into(stream, mapping[j], &stream->folded,
+                                       flush_folded);
         }
 
-        if (buf != NULL && n > 0)
-                unicode_canonical_ordering(buf + prev_start, n - prev_start);
+        segment->len = 0;
+}
 
-        if (buf != NULL)
-                buf[n] = NUL;
+static void
+flush_composed(NormalizeStream *stream)
+{
+        UnicharBuffer *composed = &stream->composed;
+
+        for (size_t i = 0; i < composed->len; i++)
+                stream->sink(composed->chars[i], stream->closure);
 
-        *buf_len = n;
+        composed->len = 0;
 }
 
-static unichar *
-normalize_wc_compose(unichar *buf, size_t len)
+static void
+compose_add(NormalizeStream *stream, unichar c)
 {
-        int new_len = len;
-        size_t prev_start = 0;
-        int prev_cc = 0;
+        if (!stream->compose) {
+                stream->sink(c, stream->closure);
+                return;
+        }
 
-        for (size_t i = 0; i < len; i++) {
-                int cc = COMBINING_CLASS(buf[i]);
-                size_t j = i - (len - new_len);
+        int cc = COMBINING_CLASS(c);
+        UnicharBuffer *composed = &stream->composed;
 
-                if (j > 0 && (prev_cc == 0 || prev_cc < cc) &&
-                    combine(buf[prev_start], buf[i], &buf[prev_start])) {
-                        new_len--;
-                        prev_cc = (j + 1 == prev_start) ?
-                                  0 : COMBINING_CLASS(buf[j - 1]);
-                } else {
+        /* ASCII characters never combine with a preceding character. */
+        if (c >= 0x80 && stream->have_starter &&
+            (stream->last_cc == 0 || stream->last_cc < cc) &&
+            combine(composed->chars[0], c, &composed->chars[0]))
+                return;
+
+        if (cc == 0) {
+                flush_composed(stream);
+                stream->have_starter = true;
+        }
+
+        unichar_buffer_append(composed, c);
+        stream->last_cc = cc;
+}
+
+void
+normalize_stream_init(NormalizeStream *stream, NormalizeMode mode,
+                      UnicharSink sink, void *closure)
+{
+        stream->compat = (mode == NORMALIZE_NFKC || mode == NORMALIZE_NFKD);
+        stream->compose = (mode == NORMALIZE_NFC || mode == NORMALIZE_NFKC ||
+                           mode == NORMALIZE_NFKC_CASEFOLD);
+        stream->fold = (mode == NORMALIZE_NFKC_CASEFOLD);
+        stream->sink = sink;
+        stream->closure = closure;
+        unichar_buffer_init(&stream->decomposed);
+        unichar_buffer_init(&stream->folded);
+        unichar_buffer_init(&stream->composed);
+        stream->have_starter = false;
+        stream->last_cc = 0;
+}
+
+void
+normalize_stream_feed(NormalizeStream *stream, const char *str, size_t max,
+                      bool use_max)
+{
+        const char *end = str + max;
+        for (const char *p = str; (!use_max || p < end) && *p != NUL; p = utf_next(p)) {
+                unsigned char b = *(const unsigned char *)p;
+                if (b >= 0x80) {
+                        decompose_into(stream, utf_char(p), &stream->decomposed,
+                                       flush_decomposed);
+                        continue;
+                }
+
+                /* ASCII characters are starters that neither decompose nor
+                 * map to anything but ASCII, so we can skip right ahead to
+                 * composition. */
+                if (stream->decomposed.len > 0)
+                        flush_decomposed(stream);
+                if (stream->folded.len > 0)
+                        flush_folded(stream);
+                if (stream->fold && b >= 'A' && b <= 'Z')
+                        b += 'a' - 'A';
+                compose_add(stream, b);
+        }
+}
+
+void
+normalize_stream_finish(NormalizeStream *stream)
+{
+        if (stream->decomposed.len > 0)
+                flush_decomposed(stream);
+        if (stream->folded.len > 0)
+                flush_folded(stream);
+        flush_composed(stream);
+
+        normalize_stream_free(stream);
+}
+
+/* {{{1
+ * Free the buffers of ‘stream’, dropping anything that hasn’t been passed
+ * on, so that it may be fed again.
+ */
+void
+normalize_stream_free(NormalizeStream *stream)
+{
+        unichar_buffer_free(&stream->decomposed);
+        unichar_buffer_free(&stream->folded);
+        unichar_buffer_free(&stream->composed);
+        stream->have_starter = false;
+        stream->last_cc = 0;
+}
+
+
+/* {{{1
+ * Set ‘no’ and ‘maybe’ to the quick check flags of normalization form ‘mode’.
+ */
+static void
+quick_check_flags(NormalizeMode mode, uint8_t *no, uint8_t *maybe)
+{
+        switch (mode) {
+        case NORMALIZE_NFD:
+                *no = UNICODE_QUICK_CHECK_NFD_NO;
+                *maybe = 0;
+                break;
+        case NORMALIZE_NFC:
+                *no = UNICODE_QUICK_CHECK_NFC_NO;
+                *maybe = UNICODE_QUICK_CHECK_NFC_MAYBE;
+                break;
+        case NORMALIZE_NFKD:
+                *no = UNICODE_QUICK_CHECK_NFKD_NO;
+                *maybe = 0;
+                break;
+        case NORMALIZE_NFKC_CASEFOLD:
+                *no = UNICODE_QUICK_CHECK_NFKC_CASEFOLD_NO;
+                *maybe = UNICODE_QUICK_CHECK_NFKC_MAYBE;
+                break;
+        case NORMALIZE_NFKC:
+        default:
+                *no = UNICODE_QUICK_CHECK_NFKC_NO;
+                *maybe = UNICODE_QUICK_CHECK_NFKC_MAYBE;
+                break;
+        }
+}
+
+
+/* {{{1
+ * ASCII characters are starters that are normalized in all forms, so we can
+ * check them without looking them up, except that uppercase letters are
+ * changed by NFKC_Casefold.  ‘unstable’ holds the quick check flags of the
+ * form.
+ */
+static inline bool
+is_stable_ascii(unsigned char b, uint8_t unstable)
+{
+        return (unstable & UNICODE_QUICK_CHECK_NFKC_CASEFOLD_NO) == 0 ||
+                b < 'A' || b > 'Z';
+}
+
+
+/* {{{1
+ * Check whether ‘str’ is in normalization form ‘mode’ using the quick check
+ * properties of its characters, stopping at the first character that isn’t.
+ * The string must also be in canonical order, which we check by making sure
+ * that the combining classes of non-starters never decrease.
+ */
+static UnicodeQuickCheck
+utf_normalize_quick_check_impl(const char *str, size_t max, bool use_max,
+                               NormalizeMode mode)
+{
+        uint8_t no, maybe;
+        quick_check_flags(mode, &no, &maybe);
+
+        UnicodeQuickCheck result = UNICODE_QUICK_CHECK_YES;
+        int last_cc = 0;
+        const char *p = str;
+        const char *end = str + max;
+        while ((!use_max || p < end) && *p != NUL) {
+                unsigned char b = *(const unsigned char *)p;
+                if (b < 0x80) {
+                        if (!is_stable_ascii(b, no))
+                                return UNICODE_QUICK_CHECK_NO;
+                        last_cc = 0;
+                        p++;
+                        continue;
+                }
+
+                unichar c = utf_char(p);
+                int cc = COMBINING_CLASS(c);
+                if (cc != 0 && last_cc > cc)
+                        return UNICODE_QUICK_CHECK_NO;
+
+                uint8_t qc = QUICK_CHECK(c);
+                if ((qc & no) != 0)
+                        return UNICODE_QUICK_CHECK_NO;
+                if ((qc & maybe) != 0)
+                        result = UNICODE_QUICK_CHECK_MAYBE;
+
+                last_cc = cc;
+                p = utf_next(p);
+        }
+
+        return result;
+}
+
+
+/* {{{1
+ * Check whether ‘str’ is in normalization form ‘mode’ without normalizing it.
+ * Returns UNICODE_QUICK_CHECK_MAYBE if this can’t be determined without
+ * normalizing it.
+ */
+UnicodeQuickCheck
+utf_normalize_quick_check(const char *str, NormalizeMode mode)
+{
+        return utf_normalize_quick_check_impl(str, 0, false, mode);
+}
+
+
+/* {{{1
+ * This function is the same as utf_normalize_quick_check() except that at
+ * most ‘len’ bytes are checked from ‘str’.
+ */
+UnicodeQuickCheck
+utf_normalize_quick_check_n(const char *str, NormalizeMode mode, size_t len)
+{
+        return utf_normalize_quick_check_impl(str, len, true, mode);
+}
+
+
+/* {{{1
+ * The real implementation of utf_is_normalized() and utf_is_normalized_n()
+ * below.  We only normalize ‘str’ if the quick check can’t tell.
+ */
+static char *utf_normalize_impl(const char *str, size_t max, bool use_max,
+                                NormalizeMode mode);
+
+static bool
+utf_is_normalized_impl(const char *str, size_t max, bool use_max,
+                       NormalizeMode mode)
+{
+        switch (utf_normalize_quick_check_impl(str, max, use_max, mode)) {
+        case UNICODE_QUICK_CHECK_YES:
+                return true;
+        case UNICODE_QUICK_CHECK_NO:
+                return false;
+        case UNICODE_QUICK_CHECK_MAYBE:
+        default:
+                break;
+        }
+
+        size_t len = use_max ? max : strlen(str);
+        const char *nul = use_max ? memchr(str, NUL, max) : NULL;
+        if (nul != NULL)
+                len = nul - str;
+        char *normalized = utf_normalize_impl(str, max, use_max, mode);
+
+        bool result = (strlen(normalized) == len &&
+                       memcmp(normalized, str, len) == 0);
+
+        free(normalized);
+
+        return result;
+}
+
+
+/* {{{1
+ * Check whether ‘str’ is in normalization form ‘mode’.
+ */
+bool
+utf_is_normalized(const char *str, NormalizeMode mode)
+{
+        return utf_is_normalized_impl(str, 0, false, mode);
+}
+
+
+/* {{{1
+ * This function is the same as utf_is_normalized() except that at most ‘len˚
+ * bytes are checked from ‘str’.
+ */
+bool
+utf_is_normalized_n(const char *str, NormalizeMode mode, size_t len)
+{
+        return utf_is_normalized_impl(str, len, true, mode);
+}
+
+
+/* {{{1
+ * A growable UTF-8 buffer for the output of normalize_into(), which is also
+ * a UnicharSink for a NormalizeStream.
+ */
+typedef struct _NormalizeOutput NormalizeOutput;
+
+struct _NormalizeOutput {
+        char *str;
+        size_t len;
+        size_t capacity;
+};
+
+static void
+normalize_output_init(NormalizeOutput *output, size_t capacity)
+{
+        output->len = 0;
+        output->capacity = capacity;
+        output->str = NORMALIZE_ALLOC_N(char, output->capacity + 1);
+}
+
+static char *
+normalize_output_finish(NormalizeOutput *output)
+{
+        output->str[output->len] = NUL;
+
+        return output->str;
+}
+
+static void
+normalize_output_reserve(NormalizeOutput *output, size_t n)
+{
+        if (output->len + n <= output->capacity)
+                return;
+
+        while (output->len + n > output->capacity)
+                output->capacity = 2 * output->capacity + 16;
+        NORMALIZE_REALLOC_N(output->str, char, output->capacity + 1);
+}
+
+static void
+normalize_output_append(NormalizeOutput *output, const char *str, size_t n)
+{
+        normalize_output_reserve(output, n);
+        memcpy(output->str + output->len, str, n);
+        output->len += n;
+}
+
+static void
+normalize_output_unichar(unichar c, void *closure)
+{
+        NormalizeOutput *output = closure;
+
+        normalize_output_reserve(output, 6);
+        output->len += unichar_to_utf(c, output->str + output->len);
+}
+
+
+/* {{{1
+ * A starter that the quick check says is normalized is a boundary: nothing
+ * before it can interact with it or anything after it.
+ */
+static bool
+is_normalize_boundary(const char *p, uint8_t unstable)
+{
+        unsigned char b = *(const unsigned char *)p;
+        if (b < 0x80)
+                return is_stable_ascii(b, unstable);
+
+        unichar c = utf_char(p);
+
+        return COMBINING_CLASS(c) == 0 && (QUICK_CHECK(c) & unstable) == 0;
+}
+
+
+/* {{{1
+ * Return a pointer to the first boundary between ‘p’ and ‘end’, or NULL if
+ * there is none.  Any continuation bytes at ‘p’ belong to a character that
+ * began in an earlier chunk and are skipped.
+ */
+static const char *
+first_normalize_boundary(const char *p, const char *end, uint8_t unstable)
+{
+        while (p < end && (*p & 0xc0) == 0x80)
+                p++;
+
+        while (p < end) {
+                const char *next = utf_next(p);
+                if (next > end)
+                        break;
+                if (is_normalize_boundary(p, unstable))
+                        return p;
+                p = next;
+        }
+
+        return NULL;
+}
+
+
+/* {{{1
+ * Return a pointer to the last boundary between ‘begin’ and ‘end’, or NULL
+ * if there is none.
+ */
+static const char *
+last_normalize_boundary(const char *begin, const char *end, uint8_t unstable)
+{
+        const char *p = end;
+        while (p > begin) {
+                p--;
+                if ((*p & 0xc0) == 0x80)
+                        continue;
+                if (utf_next(p) <= end && is_normalize_boundary(p, unstable))
+                        return p;
+        }
+
+        return NULL;
+}
+
+
+/* {{{1
+ * Find the next part of ‘p’ that may not be in normalization form
+ * ‘unstable’.  We skip characters that the quick check says are normalized,
+ * as long as non-starters stay in canonical order, until we find one that
+ * may not be.  The part then runs from the preceding boundary to the
+ * following one and is stored in ‘begin’ and ‘stop’.  If there is no such
+ * part, both are set to where we stopped looking and false is returned.
+ */
+static bool
+next_unstable_segment(const char *p, const char *end, bool use_max,
+                      uint8_t unstable, const char **begin, const char **stop)
+{
+        const char *boundary = p;
+        int last_cc = 0;
+        while ((!use_max || p < end) && *p != NUL) {
+                /* Nothing combines with what precedes an ASCII character,
+                 * so one that isn’t stable can begin the part itself. */
+                unsigned char b = *(const unsigned char *)p;
+                if (b < 0x80) {
+                        boundary = p;
+                        if (is_stable_ascii(b, unstable)) {
+                                last_cc = 0;
+                                p++;
+                                continue;
+                        }
+                }
+
+                unichar c = utf_char(p);
+                int cc = COMBINING_CLASS(c);
+                if ((QUICK_CHECK(c) & unstable) == 0) {
                         if (cc == 0)
-                                prev_start = j;
+                                boundary = p;
+                        if (cc == 0 || last_cc <= cc) {
+                                last_cc = cc;
+                                p = utf_next(p);
+                                continue;
+                        }
+                }
+
+                p = utf_next(p);
+                while ((!use_max || p < end) && *p != NUL &&
+                       !is_normalize_boundary(p, unstable))
+                        p = utf_next(p);
+
+                *begin = boundary;
+                *stop = p;
+                return true;
+        }
 
-                        buf[j] = buf[i];
-                        prev_cc = cc;
+        *begin = *stop = p;
+        return false;
+}
+
+
+/* {{{1
+ * Append ‘str’ in normalization form ‘mode’ to ‘output’.  We copy ‘str’ to
+ * the output as is, except for the parts that next_unstable_segment() finds,
+ * which we normalize with ‘stream’, a NormalizeStream that feeds ‘output’
+ * and only holds onto the current segment.
+ */
+static void
+normalize_into_stream(NormalizeOutput *output, NormalizeStream *stream,
+                      const char *str, size_t max, bool use_max,
+                      NormalizeMode mode)
+{
+        uint8_t no, maybe;
+        quick_check_flags(mode, &no, &maybe);
+        uint8_t unstable = no | maybe;
+
+        const char *end = str + max;
+        const char *copied = str;
+        const char *begin, *stop;
+        while (next_unstable_segment(copied, end, use_max, unstable,
+                                     &begin, &stop)) {
+                normalize_output_append(output, copied, begin - copied);
+                if (stop - begin == 1 && *begin >= 'A' && *begin <= 'Z') {
+                        /* An uppercase letter on its own, which only
+                         * NFKC_Casefold considers unstable, just needs to
+                         * be lowercased. */
+                        char lower = *begin + ('a' - 'A');
+                        normalize_output_append(output, &lower, 1);
+                } else {
+                        normalize_stream_feed(stream, begin, stop - begin,
+                                              true);
+                        normalize_stream_finish(stream);
                 }
+                copied = stop;
         }
 
-        buf[new_len] = NUL;
+        normalize_output_append(output, copied, stop - copied);
+}
 
-        return buf;
+static void
+normalize_into(NormalizeOutput *output, const char *str, size_t max,
+               bool use_max, NormalizeMode mode)
+{
+        NormalizeStream stream;
+        normalize_stream_init(&stream, mode, normalize_output_unichar, output);
+
+        normalize_into_stream(output, &stream, str, max, use_max, mode);
 }
 
-unichar *
-_utf_normalize_wc(const char *str, size_t max_len, bool use_len, NormalizeMode mode)
+
+#ifdef HAVE_PTHREAD_H
+/* {{{1
+ * Strings of at least twice NORMALIZE_PARALLEL_MIN_LENGTH bytes are split at
+ * boundaries into one job per processor, at most NORMALIZE_PARALLEL_MAX_JOBS
+ * of them, each at least NORMALIZE_PARALLEL_MIN_LENGTH bytes long.  As
+ * nothing on one side of a boundary affects the other, the jobs can be
+ * normalized independently and their outputs concatenated.
+ */
+#define NORMALIZE_PARALLEL_MIN_LENGTH (1 << 20)
+#define NORMALIZE_PARALLEL_MAX_JOBS 64
+
+typedef struct _NormalizeJob NormalizeJob;
+
+struct _NormalizeJob {
+        const char *str;
+        size_t len;
+        NormalizeMode mode;
+        NormalizeOutput output;
+        NormalizeStream stream;
+        bool done;
+};
+
+static void
+normalize_job_run(void *closure)
 {
-        size_t n;
-        normalize_wc_decompose(str, max_len, use_len, mode, NULL, &n);
-        unichar *buf = ALLOC_N(unichar, n + 1);
-        normalize_wc_decompose(str, max_len, use_len, mode, buf, &n);
+        NormalizeJob *job = closure;
 
-        /* Just return if we don’t want composition. */
-        if (!(mode == NORMALIZE_NFC || mode == NORMALIZE_NFKC))
-                return buf;
+        normalize_output_init(&job->output, job->len);
+        normalize_into_stream(&job->output, &job->stream, job->str, job->len,
+                              true, job->mode);
+        job->done = true;
+}
+
+static void *
+normalize_job_worker(void *closure)
+{
+        normalize_guard(normalize_job_run, closure);
 
-        return normalize_wc_compose(buf, n);
+        return NULL;
+}
+
+/* {{{1
+ * Normalize the ‘len’ bytes at ‘str’ in parallel, returning NULL if they
+ * aren’t worth splitting or if we run out of memory.  The main thread takes
+ * the first job itself, and any job that it couldn’t start a thread for, all
+ * under normalize_guard() just like the workers, so that nothing can raise
+ * while they’re running.  If any job fails, we free everything and leave it
+ * to the caller to normalize ‘str’ on its own, which raises NoMemError
+ * properly if it runs out of memory as well.  Ruby 1.8 has no global
+ * interpreter lock to release, as all Ruby threads run on this one, so the
+ * interpreter simply waits for us, as it would for any other call.  The
+ * workers never call into Ruby and block all signals, leaving those to the
+ * main thread.
+ */
+static char *
+utf_normalize_parallel(const char *str, size_t len, NormalizeMode mode)
+{
+        long n_processors = sysconf(_SC_NPROCESSORS_ONLN);
+        size_t n_jobs = len / NORMALIZE_PARALLEL_MIN_LENGTH;
+        if (n_processors > 0 && (size_t)n_processors < n_jobs)
+                n_jobs = n_processors;
+        if (n_jobs > NORMALIZE_PARALLEL_MAX_JOBS)
+                n_jobs = NORMALIZE_PARALLEL_MAX_JOBS;
+        if (n_processors < 2 || n_jobs < 2)
+                return NULL;
+
+        uint8_t no, maybe;
+        quick_check_flags(mode, &no, &maybe);
+        uint8_t unstable = no | maybe;
+
+        NormalizeJob jobs[NORMALIZE_PARALLEL_MAX_JOBS];
+        const char *end = str + len;
+        const char *p = str;
+        size_t n = 0;
+        for (size_t i = 1; i <= n_jobs && p < end; i++) {
+                const char *split = end;
+                if (i < n_jobs) {
+                        split = first_normalize_boundary(str + i * (len / n_jobs),
+                                                         end, unstable);
+                        if (split == NULL)
+                                split = end;
+                        else if (split <= p)
+                                continue;
+                }
+
+                jobs[n].str = p;
+                jobs[n].len = split - p;
+                jobs[n].mode = mode;
+                jobs[n].output.str = NULL;
+                normalize_stream_init(&jobs[n].stream, mode,
+                                      normalize_output_unichar,
+                                      &jobs[n].output);
+                jobs[n].done = false;
+                n++;
+                p = split;
+        }
+
+        sigset_t all_signals, signals;
+        sigfillset(&all_signals);
+        pthread_sigmask(SIG_SETMASK, &all_signals, &signals);
+        pthread_t threads[NORMALIZE_PARALLEL_MAX_JOBS];
+        bool started[NORMALIZE_PARALLEL_MAX_JOBS];
+        for (size_t i = 1; i < n; i++)
+                started[i] = pthread_create(&threads[i], NULL,
+                                            normalize_job_worker,
+                                            &jobs[i]) == 0;
+        pthread_sigmask(SIG_SETMASK, &signals, NULL);
+
+        normalize_guard(normalize_job_run, &jobs[0]);
+
+        for (size_t i = 1; i < n; i++)
+                if (started[i])
+                        pthread_join(threads[i], NULL);
+
+        bool done = jobs[0].done;
+        size_t total = jobs[0].output.len;
+        for (size_t i = 1; i < n && done; i++) {
+                if (!started[i])
+                        normalize_guard(normalize_job_run, &jobs[i]);
+                done = jobs[i].done;
+                total += jobs[i].output.len;
+        }
+
+        char *result = NULL;
+        if (done)
+                result = realloc(jobs[0].output.str, total + 1);
+        if (result == NULL) {
+                for (size_t i = 0; i < n; i++) {
+                        free(jobs[i].output.str);
+                        normalize_stream_free(&jobs[i].stream);
+                }
+                return NULL;
+        }
+
+        size_t offset = jobs[0].output.len;
+        for (size_t i = 1; i < n; i++) {
+                memcpy(result + offset, jobs[i].output.str,
+                       jobs[i].output.len);
+                offset += jobs[i].output.len;
+                free(jobs[i].output.str);
+        }
+        result[total] = NUL;
+
+        return result;
+}
+#endif
+
+
+/* {{{1
+ * The real implementation of utf_normalize() and utf_normalize_n() below.
+ * The output buffer starts out as large as the input, which is enough for
+ * strings that are already normalized and for most compositions.
+ */
+static char *
+utf_normalize_impl(const char *str, size_t max, bool use_max,
+                   NormalizeMode mode)
+{
+        size_t len = use_max ? max : strlen(str);
+
+#ifdef HAVE_PTHREAD_H
+        if (len >= 2 * NORMALIZE_PARALLEL_MIN_LENGTH) {
+                const char *nul = use_max ? memchr(str, NUL, len) : NULL;
+                char *result = utf_normalize_parallel(str,
+                                                      nul != NULL ?
+                                                      (size_t)(nul - str) : len,
+                                                      mode);
+                if (result != NULL)
+                        return result;
+        }
+#endif
+
+        NormalizeOutput output;
+        normalize_output_init(&output, len);
+
+        normalize_into(&output, str, max, use_max, mode);
+
+        return normalize_output_finish(&output);
 }
 
 
@@ -418,11 +1214,7 @@ _utf_normalize_wc(const char *str, size_t max_len, bool use_len, NormalizeMode m
 char *
 utf_normalize(const char *str, NormalizeMode mode)
 {
-        unichar *wcs = _utf_normalize_wc(str, 0, false, mode);
-        char *utf = ucs4_to_utf8(wcs, NULL, NULL);
-
-        free(wcs);
-        return utf;
+        return utf_normalize_impl(str, 0, false, mode);
 }
 
 
@@ -433,11 +1225,236 @@ utf_normalize(const char *str, NormalizeMode mode)
 char *
 utf_normalize_n(const char *str, NormalizeMode mode, size_t len)
 {
-        unichar *wcs = _utf_normalize_wc(str, len, true, mode);
-        char *utf = ucs4_to_utf8(wcs, NULL, NULL);
+        return utf_normalize_impl(str, len, true, mode);
+}
+
+
+/* {{{1
+ * Normalize the ‘*len’ bytes at ‘str’, which must have room for one more,
+ * in place, setting ‘*len’ to the normalized length and ‘changed’ to
+ * whether anything changed.  Each unstable segment is normalized on the
+ * side and written back over the input, which works as long as no segment
+ * grows more than the segments before it have shrunk.  If one does, the
+ * normalized string is moved to a new buffer that is returned instead of
+ * ‘str’; otherwise ‘str’ is returned.
+ */
+char *
+utf_normalize_in_place(char *str, size_t *len, NormalizeMode mode,
+                       bool *changed)
+{
+        uint8_t no, maybe;
+        quick_check_flags(mode, &no, &maybe);
+        uint8_t unstable = no | maybe;
+
+        NormalizeOutput segment;
+        normalize_output_init(&segment, 0);
+        NormalizeStream stream;
+        normalize_stream_init(&stream, mode, normalize_output_unichar,
+                              &segment);
+
+        *changed = false;
+
+        const char *end = str + *len;
+        char *written = str;
+        const char *copied = str;
+        const char *begin, *stop;
+        while (next_unstable_segment(copied, end, true, unstable,
+                                     &begin, &stop)) {
+                memmove(written, copied, begin - copied);
+                written += begin - copied;
+
+                segment.len = 0;
+                normalize_stream_feed(&stream, begin, stop - begin, true);
+                normalize_stream_finish(&stream);
+
+                if (segment.len != (size_t)(stop - begin) ||
+                    memcmp(segment.str, begin, segment.len) != 0)
+                        *changed = true;
+
+                if (written + segment.len > stop) {
+                        NormalizeOutput output;
+                        normalize_output_init(&output,
+                                              (written - str) + segment.len +
+                                              (end - stop));
+                        normalize_output_append(&output, str, written - str);
+                        normalize_output_append(&output, segment.str,
+                                                segment.len);
+                        normalize_into(&output, stop, end - stop, true, mode);
+                        free(segment.str);
+
+                        *len = output.len;
+                        return normalize_output_finish(&output);
+                }
+
+                memcpy(written, segment.str, segment.len);
+                written += segment.len;
+                copied = stop;
+        }
+        free(segment.str);
+
+        memmove(written, copied, end - copied);
+        written += end - copied;
+        *written = NUL;
+
+        *len = written - str;
+        return str;
+}
+
+
+/* {{{1
+ * A UTFNormalizer normalizes a string that arrives in chunks.  Everything
+ * up to the last boundary (see is_normalize_boundary()) of the input seen so
+ * far can be normalized right away, as nothing that follows can change it.
+ * Only the rest, which is usually just the last character or two, is held
+ * in ‘pending’ until the next chunk arrives, so memory use doesn’t depend on
+ * the size of the input.  A chunk may also end in the middle of a
+ * character, in which case its first bytes are held in ‘pending’ as well.
+ */
+struct _UTFNormalizer {
+        NormalizeMode mode;
+        uint8_t unstable;
+        char *pending;
+        size_t pending_len;
+        size_t pending_capacity;
+};
+
+UTFNormalizer *
+utf_normalizer_new(NormalizeMode mode)
+{
+        UTFNormalizer *normalizer = ALLOC(UTFNormalizer);
+
+        uint8_t no, maybe;
+        quick_check_flags(mode, &no, &maybe);
+
+        normalizer->mode = mode;
+        normalizer->unstable = no | maybe;
+        normalizer->pending = NULL;
+        normalizer->pending_len = 0;
+        normalizer->pending_capacity = 0;
+
+        return normalizer;
+}
+
+
+/* {{{1
+ * Free ‘normalizer’ and any input that it is still holding onto.
+ */
+void
+utf_normalizer_free(UTFNormalizer *normalizer)
+{
+        free(normalizer->pending);
+        free(normalizer);
+}
+
+
+/* {{{1
+ * Append ‘len’ bytes from ‘str’ to the pending input of ‘normalizer’.
+ */
+static void
+utf_normalizer_hold(UTFNormalizer *normalizer, const char *str, size_t len)
+{
+        if (normalizer->pending_len + len > normalizer->pending_capacity) {
+                while (normalizer->pending_len + len >
+                       normalizer->pending_capacity)
+                        normalizer->pending_capacity =
+                                2 * normalizer->pending_capacity + 16;
+                REALLOC_N(normalizer->pending, char,
+                          normalizer->pending_capacity);
+        }
+
+        memcpy(normalizer->pending + normalizer->pending_len, str, len);
+        normalizer->pending_len += len;
+}
+
+
+/* {{{1
+ * Append the ‘len’ bytes at ‘str’ in normalization form ‘mode’ to ‘output’.
+ * normalize_into() stops at the first NUL, so we normalize the parts between
+ * NULs one at a time and pass the NULs through, as they’re starters that
+ * nothing combines with.
+ */
+static void
+normalize_into_with_nuls(NormalizeOutput *output, const char *str,
+                         size_t len, NormalizeMode mode)
+{
+        const char *end = str + len;
+        const char *nul;
+        while ((nul = memchr(str, NUL, end - str)) != NULL) {
+                normalize_into(output, str, nul - str, true, mode);
+                normalize_output_append(output, "", 1);
+                str = nul + 1;
+        }
+        normalize_into(output, str, end - str, true, mode);
+}
+
+
+/* {{{1
+ * Feed ‘len’ bytes from ‘str’ to ‘normalizer’ and return as much of the
+ * normalized input as can be determined so far, storing its length in
+ * ‘new_len’.  The result may be empty and may contain NULs.
+ */
+char *
+utf_normalizer_feed(UTFNormalizer *normalizer, const char *str, size_t len,
+                    size_t *new_len)
+{
+        NormalizeOutput output;
+        const char *end = str + len;
+        const char *first = first_normalize_boundary(str, end,
+                                                     normalizer->unstable);
+        if (first == NULL) {
+                utf_normalizer_hold(normalizer, str, len);
+                normalize_output_init(&output, 0);
+                *new_len = 0;
+                return normalize_output_finish(&output);
+        }
+
+        utf_normalizer_hold(normalizer, str, first - str);
+        const char *last = last_normalize_boundary(first, end,
+                                                   normalizer->unstable);
+
+        normalize_output_init(&output,
+                              normalizer->pending_len + (last - first));
+        normalize_into_with_nuls(&output, normalizer->pending,
+                                 normalizer->pending_len, normalizer->mode);
+        normalize_into_with_nuls(&output, first, last - first,
+                                 normalizer->mode);
+
+        normalizer->pending_len = 0;
+        utf_normalizer_hold(normalizer, last, end - last);
+
+        *new_len = output.len;
+        return normalize_output_finish(&output);
+}
+
+
+/* {{{1
+ * Normalize and return whatever input ‘normalizer’ is still holding onto,
+ * storing its length in ‘len’ and leaving it ready to normalize another
+ * string.  Returns NULL if the input ended in the middle of a character.
+ */
+char *
+utf_normalizer_finish(UTFNormalizer *normalizer, size_t *len)
+{
+        const char *end = normalizer->pending + normalizer->pending_len;
+        const char *p = end;
+        while (p > normalizer->pending && (*(p - 1) & 0xc0) == 0x80)
+                p--;
+        bool incomplete = p > normalizer->pending && utf_next(p - 1) > end;
+
+        char *result = NULL;
+        if (!incomplete) {
+                NormalizeOutput output;
+                normalize_output_init(&output, normalizer->pending_len);
+                normalize_into_with_nuls(&output, normalizer->pending,
+                                         normalizer->pending_len,
+                                         normalizer->mode);
+                *len = output.len;
+                result = normalize_output_finish(&output);
+        }
+
+        normalizer->pending_len = 0;
 
-        free(wcs);
-        return utf;
+        return result;
 }
 
 
@@ -18,7 +18,7 @@ try_compiler_option '-Wextra'
 try_compiler_option '-Wformat=2'
 try_compiler_option '-Winit-self'
 try_compiler_option '-Winline'
-# NOTE: We need bigger ones for TR_TABLE_SIZE.
+# NOTE: The Unicode data tables are bigger than this.
 #try_compiler_option '-Wlarger-than-65500'
 try_compiler_option '-Wmissing-declarations'
 try_compiler_option '-Wmissing-format-attribute'
@@ -72,6 +72,8 @@ have_header 'string.h'
 have_header 'sys/types.h'
 have_header 'wchar.h'
 
+have_header 'pthread.h' if have_library 'pthread', 'pthread_create'
+
 $INSTALLFILES ||= []
 $INSTALLFILES << ['unicode.h', '$(RUBYARCHDIR)', 'lib']
 
@@ -0,0 +1,100 @@
+/*
+ * contents: Hashing of strings independently of case and normalization.
+ *
+ * Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+ */
+
+#include <ruby.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "unicode.h"
+
+#include "private.h"
+
+
+/* {{{1
+ * Mix ‘c’ into the hash pointed to by ‘closure’.  This is FNV-1a, but on
+ * whole characters instead of bytes.  As characters are at most 21 bits, the
+ * result is run through fmix64() once all characters have been mixed in.
+ */
+static void
+hash_unichar(unichar c, void *closure)
+{
+        uint64_t *hash = closure;
+
+        *hash = (*hash ^ c) * FNV_PRIME_64;
+}
+
+static uint64_t
+fmix64(uint64_t k)
+{
+        k ^= k >> 33;
+        k *= UINT64_C(0xff51afd7ed558ccd);
+        k ^= k >> 33;
+        k *= UINT64_C(0xc4ceb9fe1a85ec53);
+        k ^= k >> 33;
+
+        return k;
+}
+
+
+/* {{{1
+ * The real implementation of utf_fold_hash() and utf_fold_hash_n() below.
+ * The transformed characters are fed straight into the hash, so the
+ * transformed string is never materialized.
+ */
+static uint64_t
+utf_fold_hash_impl(const char *str, size_t max, bool use_max, FoldHashMode mode)
+{
+        uint64_t hash = FNV_OFFSET_BASIS_64;
+
+        if (mode == FOLD_HASH_CASEFOLD) {
+                UnicharFoldIterator iter;
+                unichar c;
+
+                unichar_fold_iterator_init(&iter, str, max, use_max);
+                while (unichar_fold_iterator_next(&iter, &c))
+                        hash_unichar(c, &hash);
+
+                return fmix64(hash);
+        }
+
+        NormalizeStream stream;
+        normalize_stream_init(&stream,
+                              mode == FOLD_HASH_NFC ?
+                              NORMALIZE_NFC : NORMALIZE_NFKC_CASEFOLD,
+                              hash_unichar, &hash);
+
+        normalize_stream_feed(&stream, str, max, use_max);
+        normalize_stream_finish(&stream);
+
+        return fmix64(hash);
+}
+
+
+/* {{{1
+ * Calculate a 64-bit hash of ‘str’ such that strings that are equal after
+ * case folding (FOLD_HASH_CASEFOLD), NFC normalization (FOLD_HASH_NFC), or
+ * NFKC_Casefold (FOLD_HASH_NFKC_CASEFOLD) hash equal.
+ */
+uint64_t
+utf_fold_hash(const char *str, FoldHashMode mode)
+{
+        return utf_fold_hash_impl(str, 0, false, mode);
+}
+
+
+/* {{{1
+ * This function is the same as utf_fold_hash() except that at most ‘len’
+ * bytes are hashed from ‘str’.
+ */
+uint64_t
+utf_fold_hash_n(const char *str, size_t len, FoldHashMode mode)
+{
+        return utf_fold_hash_impl(str, len, true, mode);
+}
+
+
+/* }}}1 */
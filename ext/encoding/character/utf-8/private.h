@@ -25,13 +25,21 @@
         u
 #endif
 
-#define binary_search_middle_of(begin, end)     \
-        (((unsigned)((begin) + (end))) >> 1)
+#define FNV_OFFSET_BASIS_64     UINT64_C(0xcbf29ce484222325)
+#define FNV_PRIME_64            UINT64_C(0x00000100000001b3)
 
-#define unicode_table_lookup(table, c, index)    \
-        binary_search_unicode_table(table, lengthof(table), sizeof((table)[0]), sizeof((table)[0].ch), c, index)
+/*
+ * Mix the ‘len’ bytes at ‘str’ into ‘hash’ with FNV-1a.  A new hash starts
+ * out as FNV_OFFSET_BASIS_64.
+ */
+static inline uint64_t
+fnv1a_64(uint64_t hash, const char *str, size_t len)
+{
+        for (size_t i = 0; i < len; i++)
+                hash = (hash ^ (unsigned char)str[i]) * FNV_PRIME_64;
 
-bool binary_search_unicode_table(const void *table, size_t n, size_t sizeof_entry, size_t sizeof_char, unichar c, int *index) HIDDEN;
+        return hash;
+}
 
 #define SPLIT_UNICODE_TABLE_LOOKUP_PAGE(data, part, page, c)  \
         ((part[page] >= UNICODE_MAX_TABLE_INDEX) \
@@ -45,7 +53,115 @@ bool binary_search_unicode_table(const void *table, size_t n, size_t sizeof_entr
             ? SPLIT_UNICODE_TABLE_LOOKUP_PAGE(data, part2, ((c) - UNICODE_FIRST_CHAR_PART2) >> 8, c) \
             : (fallback)))
 
-unichar *_utf_normalize_wc(const char *str, size_t max_len, bool use_len,
-                           NormalizeMode mode) HIDDEN;
+#define UNICODE_TABLE_INDEX_LOOKUP(data, table, c)      \
+        ((((c) >> 8) < lengthof(table)) \
+         ? SPLIT_UNICODE_TABLE_LOOKUP_PAGE(data, table, (c) >> 8, c) \
+         : 0)
+
+#define unicode_table_lookup(name, c, index)    \
+        ((*(index) = UNICODE_TABLE_INDEX_LOOKUP(name##_index_data, name##_index_table, c) - 1) >= 0)
+
+#ifdef HAVE_PTHREAD_H
+#  include <setjmp.h>
+
+/* The state of a thread running under normalize_guard().  ‘scratch’ is a
+ * temporary buffer of the function that is running, which is freed along
+ * with everything else if an allocation fails. */
+typedef struct _NormalizeWorker NormalizeWorker;
+
+struct _NormalizeWorker {
+        jmp_buf out_of_memory;
+        void *scratch;
+};
+
+extern __thread NormalizeWorker *normalize_worker HIDDEN;
+
+bool normalize_guard(void (*f)(void *), void *closure) HIDDEN;
+
+#  define NORMALIZE_SCRATCH(p) do {                     \
+        if (normalize_worker != NULL)                   \
+                normalize_worker->scratch = (p);        \
+} while (0)
+#else
+#  define NORMALIZE_SCRATCH(p) do { } while (0)
+#endif
+
+void *normalize_realloc(void *p, size_t size) HIDDEN;
+
+#define NORMALIZE_ALLOC_N(type, n) \
+        ((type *)normalize_realloc(NULL, sizeof(type) * (n)))
+#define NORMALIZE_REALLOC_N(var, type, n) \
+        ((var) = (type *)normalize_realloc((var), sizeof(type) * (n)))
+
+#define UNICHAR_MAX_FOLDCASE_LENGTH     3
+
+size_t _unichar_foldcase(unichar c, unichar *folded) HIDDEN;
+
+typedef struct _UnicharFoldIterator UnicharFoldIterator;
+
+struct _UnicharFoldIterator {
+        const char *p;
+        const char *end;
+        bool use_end;
+        unichar pending[UNICHAR_MAX_FOLDCASE_LENGTH];
+        size_t n_pending;
+        size_t i_pending;
+};
+
+void unichar_fold_iterator_init(UnicharFoldIterator *iter, const char *str,
+                                size_t max, bool use_max) HIDDEN;
+bool unichar_fold_iterator_next(UnicharFoldIterator *iter, unichar *c) HIDDEN;
+
+typedef void (*UnicharSink)(unichar c, void *closure);
+
+typedef struct _UnicharBuffer UnicharBuffer;
+
+struct _UnicharBuffer {
+        unichar *chars;
+        size_t len;
+        size_t capacity;
+        unichar inline_chars[32];
+};
+
+void unichar_buffer_init(UnicharBuffer *buffer) HIDDEN;
+void unichar_buffer_append(UnicharBuffer *buffer, unichar c) HIDDEN;
+void unichar_buffer_free(UnicharBuffer *buffer) HIDDEN;
+
+typedef struct _NormalizeStream NormalizeStream;
+
+struct _NormalizeStream {
+        bool compat;
+        bool compose;
+        bool fold;
+        UnicharSink sink;
+        void *closure;
+        UnicharBuffer decomposed;
+        UnicharBuffer folded;
+        UnicharBuffer composed;
+        bool have_starter;
+        int last_cc;
+};
+
+void normalize_stream_init(NormalizeStream *stream, NormalizeMode mode,
+                           UnicharSink sink, void *closure) HIDDEN;
+void normalize_stream_feed(NormalizeStream *stream, const char *str,
+                           size_t max, bool use_max) HIDDEN;
+void normalize_stream_finish(NormalizeStream *stream) HIDDEN;
+void normalize_stream_free(NormalizeStream *stream) HIDDEN;
+
+/* A string to be sorted by collation, its sort key, and its position in the
+ * sequence being sorted. */
+typedef struct _CollateSortKey CollateSortKey;
+
+struct _CollateSortKey {
+        const char *str;
+        size_t len;
+        char *key;
+        size_t key_len;
+        long index;
+};
+
+void collate_sort_keys(const UTFCollator *collator, CollateSortKey *keys,
+                       size_t n) HIDDEN;
 
 #endif /* PRIVATE_H */
@@ -32,6 +32,8 @@
 #define GREEK_CAPITAL_LETTER_SIGMA              ((unichar)0x03a3)
 #define GREEK_SMALL_LETTER_SIGMA                ((unichar)0x03c3)
 #define GREEK_SMALL_LETTER_FINAL_SIGMA          ((unichar)0x03c2)
+#define APOSTROPHE                              ((unichar)0x0027)
+#define RIGHT_SINGLE_QUOTATION_MARK             ((unichar)0x2019)
 
 #define OFFSET_IF(buf, len)    (((buf) != NULL) ? (buf) + (len) : NULL)
 
@@ -921,16 +923,244 @@ utf_downcase_n(const char *str, size_t len)
 }
 
 
+/* {{{1
+ * Do real titlecasing.  Characters with special casings have their titlecase
+ * mapping stored after their other mapping, which is where
+ * output_special_case() looks when asked for an uppercase mapping.
+ */
+static inline size_t
+real_do_totitle(unichar c, int type, char *buf)
+{
+	unichar tv = ATTTABLE(c >> 8, c & 0xff);
+
+	if (tv >= UNICODE_SPECIAL_CASE_TABLE_START &&
+            type != UNICODE_TITLECASE_LETTER)
+                return output_special_case(buf,
+                                           tv - UNICODE_SPECIAL_CASE_TABLE_START,
+                                           type, true);
+
+        return unichar_to_utf(unichar_totitle(c), buf);
+}
+
+static size_t
+real_totitle_one(const char *prev, char *buf, LocaleType locale_type)
+{
+        unichar c = utf_char(prev);
+        int type = s_type(c);
+
+        if (locale_type == LOCALE_TURKIC && c == 'i')
+                return unichar_to_utf(LATIN_CAPITAL_LETTER_I_WITH_DOT_ABOVE,
+                                      buf);
+
+        if (IS(type, OR(UNICODE_LOWERCASE_LETTER,
+                        OR(UNICODE_UPPERCASE_LETTER,
+                           OR(UNICODE_TITLECASE_LETTER, 0)))))
+                return real_do_totitle(c, type, buf);
+
+        size_t len = s_utf_skip_lengths[*(const unsigned char *)prev];
+
+        if (buf != NULL)
+                memcpy(buf, prev, len);
+
+        return len;
+}
+
+
+/* {{{1
+ * Determine whether the character at ‘prev’ continues a word.  Letters,
+ * marks, and digits do, and so do apostrophes that are followed by a letter,
+ * so that “don’t” is a single word.
+ */
+static bool
+continues_word(const char *prev, const char *p, const char *end, bool use_end)
+{
+        unichar c = utf_char(prev);
+        int type = s_type(c);
+
+        if (s_isalpha(type) || s_ismark(type) || s_isdigit(type))
+                return true;
+
+        if (c != APOSTROPHE && c != RIGHT_SINGLE_QUOTATION_MARK)
+                return false;
+
+        return (!use_end || p < end) && *p != NUL &&
+                s_isalpha(s_type(utf_char(p)));
+}
+
+
+/* {{{1
+ * The real implementation of utf_capitalize() and utf_titlecase().  If
+ * ‘all_words’ is true, titlecase the first letter of every word, otherwise
+ * only the first character of the string, and lowercase everything else.
+ */
+static size_t
+real_totitle(const char *str, size_t max, bool use_max, char *buf,
+             LocaleType locale_type, bool all_words)
+{
+	const char *p = str;
+        const char *end = str + max;
+	size_t len = 0;
+        bool in_word = false;
+
+	while ((!use_max || p < end) && *p != NUL) {
+		const char *prev = p;
+		p = utf_next(p);
+
+                bool title;
+                if (!all_words) {
+                        title = (prev == str);
+                } else if (in_word) {
+                        in_word = continues_word(prev, p, end, use_max);
+                        title = false;
+                } else {
+                        int type = s_type(utf_char(prev));
+                        in_word = s_isalpha(type) || s_isdigit(type);
+                        title = s_isalpha(type);
+                }
+
+                if (title)
+                        len += real_totitle_one(prev, OFFSET_IF(buf, len),
+                                                locale_type);
+                else
+                        len += real_tolower_one(&p, prev, OFFSET_IF(buf, len),
+                                                locale_type, end, use_max);
+	}
+
+	return len;
+}
+
+/* {{{1
+ * Wrapper around real_totitle() that allocates room for the worst case up
+ * front, so that the string only has to be traversed once.  No character
+ * expands to more than three times as many bytes when titlecased or
+ * lowercased.
+ */
+#define TITLECASE_MAX_EXPANSION 3
+
+static char *
+utf_totitle_impl(const char *str, size_t max, bool use_max, bool all_words)
+{
+	assert(str != NULL);
+
+	LocaleType locale_type = get_locale_type();
+
+        size_t str_len = use_max ? max : strlen(str);
+	char *result = ALLOC_N(char, TITLECASE_MAX_EXPANSION * str_len + 1);
+	size_t len = real_totitle(str, max, use_max, result, locale_type,
+                                  all_words);
+	result[len] = NUL;
+
+	return REALLOC_N(result, char, len + 1);
+}
+
+
+/* {{{1
+ * Convert the first character in ‘str’ to its titlecase representation and
+ * the rest to their lowercase representation if applicable.  Returns the
+ * freshly allocated representation.
+ */
+char *
+utf_capitalize(const char *str)
+{
+	return utf_totitle_impl(str, 0, false, false);
+}
+
+
+/* {{{1
+ * Convert the first character in ‘str’ to its titlecase representation and
+ * the rest to their lowercase representation if applicable.  Returns the
+ * freshly allocated representation.  Do this for at most ‘len˚ bytes from
+ * ‘str’.
+ */
+char *
+utf_capitalize_n(const char *str, size_t len)
+{
+	return utf_totitle_impl(str, len, true, false);
+}
+
+
+/* {{{1
+ * Convert the first letter of each word in ‘str’ to its titlecase
+ * representation and the rest to their lowercase representation if
+ * applicable.  Returns the freshly allocated representation.
+ */
+char *
+utf_titlecase(const char *str)
+{
+	return utf_totitle_impl(str, 0, false, true);
+}
+
+
+/* {{{1
+ * Convert the first letter of each word in ‘str’ to its titlecase
+ * representation and the rest to their lowercase representation if
+ * applicable.  Returns the freshly allocated representation.  Do this for at
+ * most ‘len˚ bytes from ‘str’.
+ */
+char *
+utf_titlecase_n(const char *str, size_t len)
+{
+	return utf_totitle_impl(str, len, true, true);
+}
+
+
 /* {{{1
  * The real implementation of case folding below.
+ *
+ * Fold a run of ASCII characters starting at ‘*p’, storing the result in ‘buf’
+ * (if non-‹NULL›) and advancing ‘*p’ to the first non-ASCII character (or
+ * ‹NUL›).  When we know where the string ends, eight characters are processed
+ * at a time by checking for non-ASCII or ‹NUL› bytes in a 64-bit word and, if
+ * there are none, setting bit 5 of every byte that lies in [A-Z].
  */
+#define ONES_64         UINT64_C(0x0101010101010101)
+#define HIGH_BITS_64    UINT64_C(0x8080808080808080)
+
+static size_t
+foldcase_ascii(const char **p_inout, const char *end, bool use_end, char *buf)
+{
+        const unsigned char *p = (const unsigned char *)*p_inout;
+        const unsigned char *begin = p;
+
+        if (use_end) {
+                while ((const char *)p + sizeof(uint64_t) <= end) {
+                        uint64_t word;
+                        memcpy(&word, p, sizeof(word));
+
+                        if ((word & HIGH_BITS_64) != 0 ||
+                            ((word - ONES_64) & ~word & HIGH_BITS_64) != 0)
+                                break;
+
+                        if (buf != NULL) {
+                                uint64_t at_least_A = word + ONES_64 * (0x80 - 'A');
+                                uint64_t beyond_Z = word + ONES_64 * (0x80 - 'Z' - 1);
+                                uint64_t upper = at_least_A & ~beyond_Z & HIGH_BITS_64;
+
+                                word |= upper >> 2;
+                                memcpy(buf + (p - begin), &word, sizeof(word));
+                        }
+
+                        p += sizeof(uint64_t);
+                }
+        }
+
+        while ((!use_end || (const char *)p < end) && *p != NUL && *p < 0x80) {
+                if (buf != NULL)
+                        buf[p - begin] = (*p >= 'A' && *p <= 'Z') ? *p + ('a' - 'A') : *p;
+                p++;
+        }
+
+        *p_inout = (const char *)p;
+
+        return p - begin;
+}
 
 static bool
 casefold_table_lookup(unichar c, char *folded, size_t *len)
 {
         int index;
 
-        if (!unicode_table_lookup(casefold_table, c, &index))
+        if (!unicode_table_lookup(casefold, c, &index))
                 return false;
 
         char const *folded_c = casefold_table[index].data;
@@ -943,34 +1173,54 @@ casefold_table_lookup(unichar c, char *folded, size_t *len)
         return true;
 }
 
-static char *
-utf_foldcase_impl(const char *str, size_t max, bool use_max)
+static size_t
+real_foldcase_one(unichar c, char *buf)
 {
-	assert(str != NULL);
+        if (c <= UNICODE_CASEFOLD_DIRECT_LAST &&
+            casefold_direct_table[c] != UNICODE_CASEFOLD_DIRECT_MULTIPLE)
+                return unichar_to_utf(casefold_direct_table[c], buf);
 
-	char *folded = NULL;
-	size_t len = 0;
+        size_t len = 0;
+        if (casefold_table_lookup(c, buf, &len))
+                return len;
 
-again:
-	for (const char *p = str; (!use_max || p < str + max) && *p != '\0'; p = utf_next(p)) {
-		unichar c = utf_char(p);
+        return unichar_to_utf(unichar_tolower(c), buf);
+}
+
+static size_t
+real_foldcase(const char *str, size_t max, bool use_max, char *buf)
+{
+        const char *p = str;
+        const char *end = str + max;
+        size_t len = 0;
 
-                if (casefold_table_lookup(c, OFFSET_IF(folded, len), &len))
+        while ((!use_max || p < end) && *p != NUL) {
+                if (*(const unsigned char *)p < 0x80) {
+                        len += foldcase_ascii(&p, end, use_max,
+                                              OFFSET_IF(buf, len));
                         continue;
+                }
 
-		len += unichar_to_utf(unichar_tolower(c), OFFSET_IF(folded, len));
-	}
+                unichar c = utf_char(p);
+                p = utf_next(p);
 
-	if (folded == NULL) {
-		folded = ALLOC_N(char, len + 1);
-		folded[0] = NUL;
-		len = 0;
-		goto again;
-	}
+                len += real_foldcase_one(c, OFFSET_IF(buf, len));
+        }
 
-	folded[len] = '\0';
+        return len;
+}
 
-	return folded;
+static char *
+utf_foldcase_impl(const char *str, size_t max, bool use_max)
+{
+	assert(str != NULL);
+
+        size_t len = real_foldcase(str, max, use_max, NULL);
+        char *result = ALLOC_N(char, len + 1);
+        real_foldcase(str, max, use_max, result);
+        result[len] = NUL;
+
+        return result;
 }
 
 
@@ -997,6 +1247,323 @@ utf_foldcase_n(const char *str, size_t len)
 }
 
 
+/* {{{1
+ * Store the case folding of ‘c’ in ‘folded’, which must have room for at least
+ * three characters.  Return the number of characters stored.
+ */
+size_t
+_unichar_foldcase(unichar c, unichar *folded)
+{
+        if (c <= UNICODE_CASEFOLD_DIRECT_LAST &&
+            casefold_direct_table[c] != UNICODE_CASEFOLD_DIRECT_MULTIPLE) {
+                folded[0] = casefold_direct_table[c];
+                return 1;
+        }
+
+        int index;
+        if (!unicode_table_lookup(casefold, c, &index)) {
+                folded[0] = unichar_tolower(c);
+                return 1;
+        }
+
+        size_t n = 0;
+        for (const char *p = casefold_table[index].data; *p != NUL; p = utf_next(p))
+                folded[n++] = utf_char(p);
+
+        return n;
+}
+
+
+/* {{{1
+ * Iterate over the case-folded characters of a string without allocating
+ * anything.  Characters that fold to more than one character are decoded into
+ * ‘pending’ and handed out one at a time.
+ */
+void
+unichar_fold_iterator_init(UnicharFoldIterator *iter, const char *str,
+                           size_t max, bool use_max)
+{
+        iter->p = str;
+        iter->end = str + max;
+        iter->use_end = use_max;
+        iter->n_pending = 0;
+        iter->i_pending = 0;
+}
+
+bool
+unichar_fold_iterator_next(UnicharFoldIterator *iter, unichar *c)
+{
+        if (iter->i_pending < iter->n_pending) {
+                *c = iter->pending[iter->i_pending++];
+                return true;
+        }
+
+        if ((iter->use_end && iter->p >= iter->end) || *iter->p == NUL)
+                return false;
+
+        unsigned char b = *(const unsigned char *)iter->p;
+        if (b < 0x80) {
+                iter->p++;
+                *c = (b >= 'A' && b <= 'Z') ? b + ('a' - 'A') : b;
+                return true;
+        }
+
+        unichar u = utf_char(iter->p);
+        iter->p = utf_next(iter->p);
+
+        iter->n_pending = _unichar_foldcase(u, iter->pending);
+        iter->i_pending = 1;
+        *c = iter->pending[0];
+
+        return true;
+}
+
+
+/* {{{1
+ * The real implementation of utf_casecmp() and utf_casecmp_n() below.  As
+ * long as both strings are at the start of a run of identical ASCII
+ * characters, we skip ahead eight bytes at a time.  Otherwise the strings are
+ * folded one character at a time, stopping at the first difference.
+ */
+static int
+utf_casecmp_impl(const char *a, size_t a_len, const char *b, size_t b_len,
+                 bool use_len)
+{
+        UnicharFoldIterator ia, ib;
+
+        unichar_fold_iterator_init(&ia, a, a_len, use_len);
+        unichar_fold_iterator_init(&ib, b, b_len, use_len);
+
+        while (true) {
+                if (use_len) {
+                        while (ia.p + sizeof(uint64_t) <= ia.end &&
+                               ib.p + sizeof(uint64_t) <= ib.end &&
+                               ia.i_pending >= ia.n_pending &&
+                               ib.i_pending >= ib.n_pending) {
+                                uint64_t wa, wb;
+                                memcpy(&wa, ia.p, sizeof(wa));
+                                memcpy(&wb, ib.p, sizeof(wb));
+
+                                if (wa != wb || (wa & HIGH_BITS_64) != 0 ||
+                                    ((wa - ONES_64) & ~wa & HIGH_BITS_64) != 0)
+                                        break;
+
+                                ia.p += sizeof(uint64_t);
+                                ib.p += sizeof(uint64_t);
+                        }
+                }
+
+                unichar ca, cb;
+                bool more_a = unichar_fold_iterator_next(&ia, &ca);
+                bool more_b = unichar_fold_iterator_next(&ib, &cb);
+
+                if (!more_a)
+                        return more_b ? -1 : 0;
+                if (!more_b)
+                        return 1;
+                if (ca != cb)
+                        return ca < cb ? -1 : 1;
+        }
+}
+
+
+/* {{{1
+ * Compare two strings, ignoring case.  The strings are compared character by
+ * character in the order of their case-folded code points.  Return -1, 0, or
+ * 1 if ‘a’ is less than, equal to, or greater than ‘b’.
+ */
+int
+utf_casecmp(const char *a, const char *b)
+{
+        return utf_casecmp_impl(a, 0, b, 0, false);
+}
+
+
+/* {{{1
+ * Compare two strings, ignoring case.  The strings are compared character by
+ * character in the order of their case-folded code points.  Return -1, 0, or
+ * 1 if ‘a’ is less than, equal to, or greater than ‘b’.  Do this for at most
+ * ‘a_len’ bytes from ‘a’ and at most ‘b_len’ bytes from ‘b’.
+ */
+int
+utf_casecmp_n(const char *a, size_t a_len, const char *b, size_t b_len)
+{
+        return utf_casecmp_impl(a, a_len, b, b_len, true);
+}
+
+
+/* {{{1
+ * The characters of a string for natural comparison, case-folded if ‘fold’
+ * is true, with one character of lookahead in ‘c’, which is valid as long as
+ * ‘more’ is true.
+ */
+typedef struct _NaturalIterator NaturalIterator;
+
+struct _NaturalIterator {
+        UnicharFoldIterator chars;
+        bool fold;
+        bool more;
+        unichar c;
+};
+
+static void
+natural_iterator_advance(NaturalIterator *iter)
+{
+        if (iter->fold) {
+                iter->more = unichar_fold_iterator_next(&iter->chars, &iter->c);
+                return;
+        }
+
+        UnicharFoldIterator *chars = &iter->chars;
+        iter->more = !((chars->use_end && chars->p >= chars->end) ||
+                       *chars->p == NUL);
+        if (iter->more) {
+                iter->c = utf_char(chars->p);
+                chars->p = utf_next(chars->p);
+        }
+}
+
+static void
+natural_iterator_init(NaturalIterator *iter, const char *str, size_t len,
+                      bool use_len, bool fold)
+{
+        unichar_fold_iterator_init(&iter->chars, str, len, use_len);
+        iter->fold = fold;
+        natural_iterator_advance(iter);
+}
+
+static inline int
+natural_iterator_digit(const NaturalIterator *iter)
+{
+        return iter->more ? unichar_digit_value(iter->c) : -1;
+}
+
+/* {{{1
+ * Skip the zeros at the start of a run of digits, returning how many there
+ * were.
+ */
+static size_t
+natural_iterator_skip_zeros(NaturalIterator *iter)
+{
+        size_t n = 0;
+
+        while (natural_iterator_digit(iter) == 0) {
+                natural_iterator_advance(iter);
+                n++;
+        }
+
+        return n;
+}
+
+/* {{{1
+ * Compare the runs of digits that ‘a’ and ‘b’ are at by their numeric value,
+ * leaving both after their run.  Leading zeros have already been skipped, so
+ * the longer run is the larger number, and runs of the same length are
+ * decided by their first differing digit.
+ */
+static int
+natural_compare_numbers(NaturalIterator *a, NaturalIterator *b)
+{
+        int result = 0;
+
+        while (true) {
+                int a_digit = natural_iterator_digit(a);
+                int b_digit = natural_iterator_digit(b);
+
+                if (a_digit < 0 || b_digit < 0) {
+                        if (a_digit != b_digit)
+                                result = (a_digit < 0) ? -1 : 1;
+                        break;
+                }
+
+                if (result == 0 && a_digit != b_digit)
+                        result = (a_digit < b_digit) ? -1 : 1;
+                natural_iterator_advance(a);
+                natural_iterator_advance(b);
+        }
+
+        while (natural_iterator_digit(a) >= 0)
+                natural_iterator_advance(a);
+        while (natural_iterator_digit(b) >= 0)
+                natural_iterator_advance(b);
+
+        return result;
+}
+
+/* {{{1
+ * The real implementation of utf_natural_compare() and
+ * utf_natural_compare_n() below.  Both strings are decoded, and folded if
+ * asked to, one character at a time, without allocating anything.  Runs of
+ * decimal digits, in any script, are compared by their numeric value, and
+ * everything else by code point.  Numbers that only differ in leading zeros
+ * are equal, but if nothing else differs, the string whose first such number
+ * has fewer leading zeros is less.
+ */
+static int
+utf_natural_compare_impl(const char *a, size_t a_len, const char *b,
+                         size_t b_len, bool use_len, bool fold)
+{
+        NaturalIterator ia, ib;
+        int tie = 0;
+
+        natural_iterator_init(&ia, a, a_len, use_len, fold);
+        natural_iterator_init(&ib, b, b_len, use_len, fold);
+
+        while (ia.more && ib.more) {
+                if (natural_iterator_digit(&ia) >= 0 &&
+                    natural_iterator_digit(&ib) >= 0) {
+                        size_t a_zeros = natural_iterator_skip_zeros(&ia);
+                        size_t b_zeros = natural_iterator_skip_zeros(&ib);
+
+                        int result = natural_compare_numbers(&ia, &ib);
+                        if (result != 0)
+                                return result;
+                        if (tie == 0 && a_zeros != b_zeros)
+                                tie = (a_zeros < b_zeros) ? -1 : 1;
+                        continue;
+                }
+
+                if (ia.c != ib.c)
+                        return (ia.c < ib.c) ? -1 : 1;
+                natural_iterator_advance(&ia);
+                natural_iterator_advance(&ib);
+        }
+
+        if (ia.more != ib.more)
+                return ia.more ? 1 : -1;
+
+        return tie;
+}
+
+
+/* {{{1
+ * Compare two strings in natural order, that is, with runs of decimal digits
+ * compared by their numeric value, so that “file2” is less than “file10”.
+ * If ‘fold’ is true, case is ignored, as by utf_casecmp().  Return -1, 0, or
+ * 1 if ‘a’ is less than, equal to, or greater than ‘b’.
+ */
+int
+utf_natural_compare(const char *a, const char *b, bool fold)
+{
+        return utf_natural_compare_impl(a, 0, b, 0, false, fold);
+}
+
+
+/* {{{1
+ * Compare two strings in natural order, that is, with runs of decimal digits
+ * compared by their numeric value, so that “file2” is less than “file10”.
+ * If ‘fold’ is true, case is ignored, as by utf_casecmp().  Return -1, 0, or
+ * 1 if ‘a’ is less than, equal to, or greater than ‘b’.  Do this for at most
+ * ‘a_len’ bytes from ‘a’ and at most ‘b_len’ bytes from ‘b’.
+ */
+int
+utf_natural_compare_n(const char *a, size_t a_len, const char *b, size_t b_len,
+                      bool fold)
+{
+        return utf_natural_compare_impl(a, a_len, b, b_len, true, fold);
+}
+
+
 /* {{{1
  * The real implementation of utf_width() and utf_width_n() below.
  */
@@ -1043,7 +1610,7 @@ unichar_mirror(unichar c, unichar *mirrored)
 {
         int index;
 
-        if (!unicode_table_lookup(bidi_mirroring_table, c, &index))
+        if (!unicode_table_lookup(bidi_mirroring, c, &index))
                 return false;
 
         if (mirrored != NULL)
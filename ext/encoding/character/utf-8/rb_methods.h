@@ -8,13 +8,23 @@
 #define RB_METHODS_H
 
 VALUE rb_utf_collate(UNUSED(VALUE self), VALUE str, VALUE other) HIDDEN;
+VALUE rb_utf_collate_key(UNUSED(VALUE self), VALUE str) HIDDEN;
+VALUE rb_utf_collate_key_prefix(UNUSED(VALUE self), VALUE str, VALUE rbbytes) HIDDEN;
+VALUE rb_utf_collate_key_prefixes(UNUSED(VALUE self), VALUE ary, VALUE rbbytes) HIDDEN;
+VALUE rb_utf_collate_prefix_bounds(UNUSED(VALUE self), VALUE prefix) HIDDEN;
+VALUE rb_utf_sort(UNUSED(VALUE self), VALUE ary) HIDDEN;
+VALUE rb_utf_sort_by_collation_bang(UNUSED(VALUE self), VALUE ary) HIDDEN;
 VALUE rb_utf_downcase(UNUSED(VALUE self), VALUE str) HIDDEN;
 VALUE rb_utf_length(UNUSED(VALUE self), VALUE str) HIDDEN;
 VALUE rb_utf_reverse(UNUSED(VALUE self), VALUE str) HIDDEN;
 VALUE rb_utf_upcase(UNUSED(VALUE self), VALUE str) HIDDEN;
+VALUE rb_utf_capitalize(UNUSED(VALUE self), VALUE str) HIDDEN;
+VALUE rb_utf_titlecase(UNUSED(VALUE self), VALUE str) HIDDEN;
 VALUE rb_utf_aref_m(int argc, VALUE *argv, UNUSED(VALUE self)) HIDDEN;
 VALUE rb_utf_aset_m(int argc, VALUE *argv, UNUSED(VALUE self)) HIDDEN;
 VALUE rb_utf_casecmp(UNUSED(VALUE self), VALUE str1, VALUE str2) HIDDEN;
+VALUE rb_utf_casecmp_p(UNUSED(VALUE self), VALUE str1, VALUE str2) HIDDEN;
+VALUE rb_utf_natural_compare(int argc, VALUE *argv, UNUSED(VALUE self)) HIDDEN;
 VALUE rb_utf_center(int argc, VALUE *argv, UNUSED(VALUE self)) HIDDEN;
 VALUE rb_utf_ljust(int argc, VALUE *argv, UNUSED(VALUE self)) HIDDEN;
 VALUE rb_utf_rjust(int argc, VALUE *argv, UNUSED(VALUE self)) HIDDEN;
@@ -45,5 +55,9 @@ VALUE rb_utf_tr(UNUSED(VALUE self), VALUE str, VALUE from, VALUE to) HIDDEN;
 VALUE rb_utf_tr_s(UNUSED(VALUE self), VALUE str, VALUE from, VALUE to) HIDDEN;
 VALUE rb_utf_foldcase(UNUSED(VALUE self), VALUE str) HIDDEN;
 VALUE rb_utf_normalize(int argc, VALUE *argv, UNUSED(VALUE self)) HIDDEN;
+VALUE rb_utf_normalize_bang(int argc, VALUE *argv, UNUSED(VALUE self)) HIDDEN;
+VALUE rb_utf_normalized_p(int argc, VALUE *argv, UNUSED(VALUE self)) HIDDEN;
+VALUE rb_utf_nfkc_casefold(UNUSED(VALUE self), VALUE str) HIDDEN;
+VALUE rb_utf_fold_hash(int argc, VALUE *argv, UNUSED(VALUE self)) HIDDEN;
 
 #endif /* RB_METHODS_H */
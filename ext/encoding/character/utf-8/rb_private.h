@@ -29,6 +29,8 @@ VALUE rb_utf_new5(VALUE obj, const char *str, long len) HIDDEN;
 
 VALUE rb_utf_alloc_using(char *str) HIDDEN;
 
+VALUE rb_utf_alloc_using_n(char *str, long len) HIDDEN;
+
 VALUE rb_utf_dup(VALUE str) HIDDEN;
 
 long rb_utf_index(VALUE str, VALUE sub, long offset) HIDDEN;
@@ -48,5 +50,20 @@ char *rb_utf_next_validated(const char *p, const char *end) HIDDEN;
 long rb_utf_index_regexp(VALUE str, const char *s, const char *end, VALUE sub,
                          long offset, bool reverse) HIDDEN;
 
+NormalizeMode rb_utf_symbol_to_normalize_mode(VALUE symbol) HIDDEN;
+
+void Init_utf8_normalizer(VALUE mUTF8) HIDDEN;
+
+void Init_utf8_normalize_cache(VALUE mUTF8) HIDDEN;
+
+VALUE rb_utf_sort_array(const UTFCollator *collator, VALUE ary) HIDDEN;
+
+VALUE rb_utf_collate_prefix_bounds_new(char *lower, size_t lower_len,
+                                       char *upper, size_t upper_len) HIDDEN;
+
+void Init_utf8_collator(VALUE mUTF8) HIDDEN;
+
+void Init_utf8_charset(VALUE mUTF8) HIDDEN;
+
 
 #endif /* RB_PRIVATE_H */
@@ -1,5 +1,5 @@
 /*
- * contents: UTF8.casecmp module function.
+ * contents: UTF8.casecmp module functions.
  *
  * Copyright © 2006 Nikolai Weibull <now@bitwi.se>
  */
@@ -12,13 +12,17 @@ rb_utf_casecmp(UNUSED(VALUE self), VALUE str1, VALUE str2)
         StringValue(str1);
         StringValue(str2);
 
-        char *folded1 = utf_foldcase(RSTRING(str1)->ptr);
-        char *folded2 = utf_foldcase(RSTRING(str2)->ptr);
-
-        int result = utf_collate(folded1, folded2);
+        return INT2FIX(utf_casecmp_n(RSTRING(str1)->ptr, RSTRING(str1)->len,
+                                     RSTRING(str2)->ptr, RSTRING(str2)->len));
+}
 
-        free(folded2);
-        free(folded1);
+VALUE
+rb_utf_casecmp_p(UNUSED(VALUE self), VALUE str1, VALUE str2)
+{
+        StringValue(str1);
+        StringValue(str2);
 
-        return INT2FIX(result);
+        return utf_casecmp_n(RSTRING(str1)->ptr, RSTRING(str1)->len,
+                             RSTRING(str2)->ptr, RSTRING(str2)->len) == 0 ?
+                Qtrue : Qfalse;
 }
@@ -0,0 +1,154 @@
+/*
+ * contents: Encoding::Character::UTF8::CharSet class.
+ *
+ * Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+ */
+
+#include "rb_includes.h"
+#include "rb_utf_internal_tr.h"
+
+/* {{{1
+ * A CharSet is a set of characters made from specifications like those of
+ * String#count once, so that it can be given to UTF8.count, UTF8.delete,
+ * UTF8.squeeze, and UTF8.tr over and over again without being parsed each
+ * time.  ‘spec’ is the specification it was made from, if there was only
+ * one, as UTF8.tr needs it to know what to translate each character to.
+ */
+typedef struct _CharSet CharSet;
+
+struct _CharSet {
+        struct tr_set set;
+        struct tr_range *ranges;
+        VALUE spec;
+};
+
+static VALUE cCharSet;
+
+static void
+rb_utf_charset_mark(CharSet *charset)
+{
+        rb_gc_mark(charset->spec);
+}
+
+static void
+rb_utf_charset_free(CharSet *charset)
+{
+        free(charset->ranges);
+        free(charset);
+}
+
+static VALUE
+rb_utf_charset_alloc(VALUE klass)
+{
+        CharSet *charset;
+
+        VALUE self = Data_Make_Struct(klass, CharSet, rb_utf_charset_mark,
+                                      rb_utf_charset_free, charset);
+        charset->spec = Qnil;
+
+        return self;
+}
+
+static CharSet *
+rb_utf_charset_get(VALUE self)
+{
+        CharSet *charset;
+
+        Data_Get_Struct(self, CharSet, charset);
+        if (charset->ranges == NULL)
+                rb_raise(rb_eArgError, "uninitialized character set");
+
+        return charset;
+}
+
+/* {{{1
+ * Return the set of ‘obj’ if it’s a CharSet, or NULL otherwise.
+ */
+const struct tr_set *
+rb_utf_charset_get_set(VALUE obj)
+{
+        if (TYPE(obj) != T_DATA || !rb_obj_is_kind_of(obj, cCharSet))
+                return NULL;
+
+        return &rb_utf_charset_get(obj)->set;
+}
+
+/* {{{1
+ * Return the specification that ‘charset’ was made from, raising an
+ * ArgumentError if it was made from more than one.
+ */
+VALUE
+rb_utf_charset_get_spec(VALUE charset)
+{
+        VALUE spec = rb_utf_charset_get(charset)->spec;
+
+        if (NIL_P(spec))
+                rb_raise(rb_eArgError,
+                         "character set made from more than one specification");
+
+        return spec;
+}
+
+/* {{{1
+ * Create a character set containing the characters that are included by all
+ * of ‘specs’, just as String#count would count them.  The character set is
+ * frozen, as it can’t be changed once it’s been created.
+ */
+static VALUE
+rb_utf_charset_initialize(int argc, VALUE *argv, VALUE self)
+{
+        CharSet *charset;
+
+        Data_Get_Struct(self, CharSet, charset);
+        if (OBJ_FROZEN(self))
+                rb_error_frozen("character set");
+        need_at_least_n_arguments(argc, 1);
+
+        struct tr_set set;
+        tr_set_init(&set, argc, argv);
+
+        struct tr_range *copy = ALLOC_N(struct tr_range, set.n_ranges + 1);
+        memcpy(copy, set.ranges, set.n_ranges * sizeof(struct tr_range));
+
+        free(charset->ranges);
+        charset->set = set;
+        charset->set.ranges = copy;
+        charset->set.storage = Qnil;
+        charset->ranges = copy;
+        if (argc > 1)
+                charset->spec = Qnil;
+        else if (rb_utf_charset_get_set(argv[0]) != NULL)
+                charset->spec = rb_utf_charset_get(argv[0])->spec;
+        else
+                charset->spec = rb_obj_freeze(rb_str_dup(argv[0]));
+
+        return rb_obj_freeze(self);
+}
+
+/* {{{1
+ * Check whether the first character of ‘str’ is in the character set.
+ */
+static VALUE
+rb_utf_charset_include(VALUE self, VALUE str)
+{
+        CharSet *charset = rb_utf_charset_get(self);
+
+        StringValue(str);
+        if (RSTRING(str)->len == 0)
+                return Qfalse;
+
+        unichar c = _utf_char_validated(RSTRING(str)->ptr,
+                                        RSTRING(str)->ptr + RSTRING(str)->len);
+
+        return tr_set_contains(&charset->set, c) ? Qtrue : Qfalse;
+}
+
+void
+Init_utf8_charset(VALUE mUTF8)
+{
+        cCharSet = rb_define_class_under(mUTF8, "CharSet", rb_cObject);
+
+        rb_define_alloc_func(cCharSet, rb_utf_charset_alloc);
+        rb_define_method(cCharSet, "initialize", rb_utf_charset_initialize, -1);
+        rb_define_method(cCharSet, "include?", rb_utf_charset_include, 1);
+}
@@ -9,5 +9,117 @@
 VALUE
 rb_utf_collate(UNUSED(VALUE self), VALUE str, VALUE other)
 {
-        return INT2FIX(utf_collate(StringValuePtr(str), StringValuePtr(other)));
+        StringValue(str);
+        StringValue(other);
+
+        return INT2FIX(utf_collate_n(RSTRING(str)->ptr, RSTRING(str)->len,
+                                     RSTRING(other)->ptr, RSTRING(other)->len));
+}
+
+VALUE
+rb_utf_collate_key(UNUSED(VALUE self), VALUE str)
+{
+        StringValue(str);
+
+        size_t len;
+        char *key = utf_collate_key_n(RSTRING(str)->ptr, RSTRING(str)->len,
+                                      &len);
+        VALUE rbkey = rb_str_new(key, len);
+        free(key);
+
+        return rbkey;
+}
+
+static size_t
+rb_utf_collate_key_prefix_length(VALUE rbbytes)
+{
+        long bytes = NUM2LONG(rbbytes);
+        if (bytes <= 0)
+                rb_raise(rb_eArgError,
+                         "key prefix length must be positive: %ld", bytes);
+
+        return bytes;
+}
+
+VALUE
+rb_utf_collate_key_prefix(UNUSED(VALUE self), VALUE str, VALUE rbbytes)
+{
+        size_t bytes = rb_utf_collate_key_prefix_length(rbbytes);
+
+        StringValue(str);
+
+        VALUE prefix = rb_str_buf_new(bytes);
+        utf_collate_key_prefix_n(RSTRING(str)->ptr, RSTRING(str)->len,
+                                 RSTRING(prefix)->ptr, bytes);
+        RSTRING(prefix)->len = bytes;
+        RSTRING(prefix)->ptr[bytes] = NUL;
+
+        return prefix;
+}
+
+/* {{{1
+ * Return the collation key prefixes of ‘bytes’ bytes of the strings in ‘ary’,
+ * one after the other, in a single string, so that they can be unpacked
+ * into integers, or sorted as fixed-length records, without creating a
+ * string per key.
+ */
+VALUE
+rb_utf_collate_key_prefixes(UNUSED(VALUE self), VALUE ary, VALUE rbbytes)
+{
+        size_t bytes = rb_utf_collate_key_prefix_length(rbbytes);
+
+        Check_Type(ary, T_ARRAY);
+        VALUE strs = rb_ary_dup(ary);
+        long n = RARRAY(strs)->len;
+        if ((size_t)n > LONG_MAX / bytes)
+                rb_raise(rb_eArgError, "key prefixes too long");
+
+        VALUE prefixes = rb_str_buf_new(n * bytes);
+        for (long i = 0; i < n; i++) {
+                VALUE str = RARRAY(strs)->ptr[i];
+                StringValue(str);
+                utf_collate_key_prefix_n(RSTRING(str)->ptr, RSTRING(str)->len,
+                                         RSTRING(prefixes)->ptr + i * bytes,
+                                         bytes);
+        }
+        RSTRING(prefixes)->len = n * bytes;
+        RSTRING(prefixes)->ptr[n * bytes] = NUL;
+
+        return prefixes;
+}
+
+/* {{{1
+ * Return an array of the lower and upper bounds of the sort keys, as
+ * returned by UTF8.collate_key, of the strings that begin with ‘prefix’.
+ * The lower bound is inclusive, the upper bound is exclusive, and is nil if
+ * there is none.  Takes ownership of ‘lower’ and ‘upper’.
+ */
+VALUE
+rb_utf_collate_prefix_bounds_new(char *lower, size_t lower_len, char *upper,
+                                 size_t upper_len)
+{
+        VALUE rblower = rb_str_new(lower, lower_len);
+        free(lower);
+
+        VALUE rbupper = Qnil;
+        if (upper != NULL) {
+                rbupper = rb_str_new(upper, upper_len);
+                free(upper);
+        }
+
+        return rb_assoc_new(rblower, rbupper);
+}
+
+VALUE
+rb_utf_collate_prefix_bounds(UNUSED(VALUE self), VALUE prefix)
+{
+        StringValue(prefix);
+
+        char *lower, *upper;
+        size_t lower_len, upper_len;
+        utf_collate_prefix_bounds_n(RSTRING(prefix)->ptr, RSTRING(prefix)->len,
+                                    &lower, &lower_len, &upper, &upper_len);
+
+        return rb_utf_collate_prefix_bounds_new(lower, lower_len,
+                                                upper, upper_len);
 }
@@ -0,0 +1,188 @@
+/*
+ * contents: Encoding::Character::UTF8::Collator class.
+ *
+ * Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+ */
+
+#include "rb_includes.h"
+
+#define SYMBOL2VALUE(symbol, value, id) do {            \
+        static ID id_##symbol;                          \
+        if (id_##symbol == 0)                           \
+                id_##symbol = rb_intern(#symbol);       \
+        if (id == id_##symbol)                          \
+                return value;                           \
+} while (0)
+
+static CollateStrength
+rb_utf_symbol_to_collate_strength(VALUE symbol)
+{
+        if (!SYMBOL_P(symbol))
+                rb_raise(rb_eTypeError, "not a symbol");
+
+        ID id = SYM2ID(symbol);
+
+        SYMBOL2VALUE(primary, COLLATE_STRENGTH_PRIMARY, id);
+        SYMBOL2VALUE(secondary, COLLATE_STRENGTH_SECONDARY, id);
+        SYMBOL2VALUE(tertiary, COLLATE_STRENGTH_TERTIARY, id);
+        SYMBOL2VALUE(quaternary, COLLATE_STRENGTH_QUATERNARY, id);
+
+        rb_raise(rb_eArgError, "unknown strength");
+}
+
+static CollateCaseFirst
+rb_utf_symbol_to_collate_case_first(VALUE symbol)
+{
+        if (!SYMBOL_P(symbol))
+                rb_raise(rb_eTypeError, "not a symbol");
+
+        ID id = SYM2ID(symbol);
+
+        SYMBOL2VALUE(off, COLLATE_CASE_FIRST_OFF, id);
+        SYMBOL2VALUE(upper, COLLATE_CASE_FIRST_UPPER, id);
+        SYMBOL2VALUE(lower, COLLATE_CASE_FIRST_LOWER, id);
+
+        rb_raise(rb_eArgError, "unknown case first");
+}
+
+static VALUE
+rb_utf_collator_option(VALUE options, const char *name)
+{
+        return rb_hash_aref(options, ID2SYM(rb_intern(name)));
+}
+
+static void
+rb_utf_collator_free(UTFCollator *collator)
+{
+        if (collator != NULL)
+                utf_collator_free(collator);
+}
+
+static VALUE
+rb_utf_collator_alloc(VALUE klass)
+{
+        return Data_Wrap_Struct(klass, NULL, rb_utf_collator_free, NULL);
+}
+
+static UTFCollator *
+rb_utf_collator_get(VALUE self)
+{
+        UTFCollator *collator;
+
+        Data_Get_Struct(self, UTFCollator, collator);
+        if (collator == NULL)
+                rb_raise(rb_eArgError, "uninitialized collator");
+
+        return collator;
+}
+
+/* {{{1
+ * Create a collator from a hash of options: ‘:locale’, a language code like
+ * "sv" or "sv_SE", ‘:strength’, one of ‘:primary’, ‘:secondary’,
+ * ‘:tertiary’, and ‘:quaternary’, ‘:numeric’, and ‘:case_first’, one of
+ * ‘:off’, ‘:upper’, and ‘:lower’.  The collator is frozen, as it can’t be
+ * changed once it’s been created.
+ */
+static VALUE
+rb_utf_collator_initialize(int argc, VALUE *argv, VALUE self)
+{
+        VALUE options, value;
+
+        const char *locale = NULL;
+        CollateStrength strength = COLLATE_STRENGTH_QUATERNARY;
+        bool numeric = false;
+        CollateCaseFirst case_first = COLLATE_CASE_FIRST_OFF;
+        if (OBJ_FROZEN(self))
+                rb_error_frozen("collator");
+        if (rb_scan_args(argc, argv, "01", &options) == 1 &&
+            !NIL_P(options)) {
+                Check_Type(options, T_HASH);
+
+                value = rb_utf_collator_option(options, "locale");
+                if (!NIL_P(value))
+                        locale = StringValueCStr(value);
+                value = rb_utf_collator_option(options, "strength");
+                if (!NIL_P(value))
+                        strength = rb_utf_symbol_to_collate_strength(value);
+                numeric = RTEST(rb_utf_collator_option(options, "numeric"));
+                value = rb_utf_collator_option(options, "case_first");
+                if (!NIL_P(value))
+                        case_first = rb_utf_symbol_to_collate_case_first(value);
+        }
+
+        rb_utf_collator_free(DATA_PTR(self));
+        DATA_PTR(self) = NULL;
+        DATA_PTR(self) = utf_collator_new(locale, strength, numeric,
+                                          case_first);
+
+        return rb_obj_freeze(self);
+}
+
+static VALUE
+rb_utf_collator_compare(VALUE self, VALUE str, VALUE other)
+{
+        UTFCollator *collator = rb_utf_collator_get(self);
+
+        StringValue(str);
+        StringValue(other);
+
+        return INT2FIX(utf_collator_compare_n(collator,
+                                              RSTRING(str)->ptr,
+                                              RSTRING(str)->len,
+                                              RSTRING(other)->ptr,
+                                              RSTRING(other)->len));
+}
+
+static VALUE
+rb_utf_collator_key(VALUE self, VALUE str)
+{
+        UTFCollator *collator = rb_utf_collator_get(self);
+
+        StringValue(str);
+
+        size_t len;
+        char *key = utf_collator_key_n(collator, RSTRING(str)->ptr,
+                                       RSTRING(str)->len, &len);
+        VALUE rbkey = rb_str_new(key, len);
+        free(key);
+
+        return rbkey;
+}
+
+static VALUE
+rb_utf_collator_prefix_bounds(VALUE self, VALUE prefix)
+{
+        UTFCollator *collator = rb_utf_collator_get(self);
+
+        StringValue(prefix);
+
+        char *lower, *upper;
+        size_t lower_len, upper_len;
+        utf_collator_prefix_bounds_n(collator, RSTRING(prefix)->ptr,
+                                     RSTRING(prefix)->len, &lower, &lower_len,
+                                     &upper, &upper_len);
+
+        return rb_utf_collate_prefix_bounds_new(lower, lower_len,
+                                                upper, upper_len);
+}
+
+static VALUE
+rb_utf_collator_sort(VALUE self, VALUE ary)
+{
+        return rb_utf_sort_array(rb_utf_collator_get(self), ary);
+}
+
+void
+Init_utf8_collator(VALUE mUTF8)
+{
+        VALUE cCollator = rb_define_class_under(mUTF8, "Collator", rb_cObject);
+
+        rb_define_alloc_func(cCollator, rb_utf_collator_alloc);
+        rb_define_method(cCollator, "initialize",
+                         rb_utf_collator_initialize, -1);
+        rb_define_method(cCollator, "compare", rb_utf_collator_compare, 2);
+        rb_define_method(cCollator, "key", rb_utf_collator_key, 1);
+        rb_define_method(cCollator, "prefix_bounds",
+                         rb_utf_collator_prefix_bounds, 1);
+        rb_define_method(cCollator, "sort", rb_utf_collator_sort, 1);
+}
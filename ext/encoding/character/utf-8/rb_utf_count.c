@@ -17,14 +17,16 @@ rb_utf_count(int argc, VALUE *argv, UNUSED(VALUE self))
         if (RSTRING(str)->len == 0)
                 return INT2FIX(0);
 
-        unsigned int table[TR_TABLE_SIZE];
-        tr_setup_table_from_strings(table, argc - 1, &argv[1]);
+        struct tr_set set;
+        tr_set_init(&set, argc - 1, &argv[1]);
 
         long count = 0;
         char const *p_end = RSTRING(str)->ptr + RSTRING(str)->len;
-        for (char const *p = RSTRING(str)->ptr; p < p_end; p = utf_next(p))
-                if (tr_table_lookup(table, _utf_char_validated(p, p_end)))
+        for (char const *p = RSTRING(str)->ptr; p < p_end; p = utf_next(p)) {
+                unichar c = _utf_char_validated(p, p_end);
+                if (tr_set_contains(&set, c))
                         count++;
+        }
 
         return LONG2NUM(count);
 }
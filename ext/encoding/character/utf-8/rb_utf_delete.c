@@ -17,8 +17,8 @@ rb_utf_delete_bang(int argc, VALUE *argv, UNUSED(VALUE self))
         if (RSTRING(str)->len == 0)
                 return Qnil;
 
-        unsigned int table[TR_TABLE_SIZE];
-        tr_setup_table_from_strings(table, argc - 1, &argv[1]);
+        struct tr_set set;
+        tr_set_init(&set, argc - 1, &argv[1]);
 
         rb_str_modify(str);
 
@@ -30,7 +30,7 @@ rb_utf_delete_bang(int argc, VALUE *argv, UNUSED(VALUE self))
                 unichar c = utf_char(s);
 
                 char *next = rb_utf_next_validated(s, s_end);
-                if (tr_table_lookup(table, c)) {
+                if (tr_set_contains(&set, c)) {
                         modified = true;
                 } else {
                         memmove(t, s, next - s);
@@ -0,0 +1,48 @@
+/*
+ * contents: Encoding::Character::UTF8.fold_hash module function.
+ *
+ * Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+ */
+
+#include "rb_includes.h"
+
+#define SYMBOL2MODE(symbol, mode, id) do {              \
+        static ID id_##symbol;                          \
+        if (id_##symbol == 0)                           \
+                id_##symbol = rb_intern(#symbol);       \
+        if (id == id_##symbol)                          \
+                return mode;                            \
+} while (0)
+
+static FoldHashMode
+symbol_to_fold_hash_mode(VALUE symbol)
+{
+        if (TYPE(symbol) == T_HASH)
+                symbol = rb_hash_aref(symbol, ID2SYM(rb_intern("mode")));
+
+        if (!SYMBOL_P(symbol))
+                rb_raise(rb_eTypeError, "not a symbol");
+
+        ID id = SYM2ID(symbol);
+
+        SYMBOL2MODE(nfkc_casefold, FOLD_HASH_NFKC_CASEFOLD, id);
+        SYMBOL2MODE(nfc, FOLD_HASH_NFC, id);
+        SYMBOL2MODE(casefold, FOLD_HASH_CASEFOLD, id);
+
+        rb_raise(rb_eArgError, "unknown symbol");
+}
+
+VALUE
+rb_utf_fold_hash(int argc, VALUE *argv, UNUSED(VALUE self))
+{
+        VALUE str, rbmode;
+
+        FoldHashMode mode = FOLD_HASH_NFKC_CASEFOLD;
+        if (rb_scan_args(argc, argv, "11", &str, &rbmode) == 2)
+                mode = symbol_to_fold_hash_mode(rbmode);
+
+        StringValue(str);
+
+        return ULL2NUM(utf_fold_hash_n(RSTRING(str)->ptr, RSTRING(str)->len,
+                                       mode));
+}
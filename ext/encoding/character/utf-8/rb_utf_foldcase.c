@@ -9,5 +9,8 @@
 VALUE
 rb_utf_foldcase(UNUSED(VALUE self), VALUE str)
 {
-        return rb_utf_alloc_using(utf_foldcase(StringValuePtr(str)));
+        StringValue(str);
+
+        return rb_utf_alloc_using(utf_foldcase_n(RSTRING(str)->ptr,
+                                                 RSTRING(str)->len));
 }
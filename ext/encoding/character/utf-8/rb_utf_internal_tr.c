@@ -59,10 +59,14 @@ tr_next_char(struct tr *t)
                 if (next != NULL) {
                         unichar max = utf_char(next);
 
-                        if (max < t->now) {
-                                t->p = next;
+                        /* Skip past the upper bound, so that neither it nor
+                         * the ‘-’ is read again as a character of its own. */
+                        t->p = utf_find_next(next, t->p_end);
+                        if (t->p == NULL)
+                                t->p = t->p_end;
+
+                        if (max < t->now)
                                 return TR_READ_ANOTHER;
-                        }
 
                         t->inside_range = true;
                         t->max = max;
@@ -86,57 +90,369 @@ tr_next(struct tr *t)
                 } else if (++t->now < t->max) {
                         return TR_FOUND;
                 } else {
+                        t->now = t->max;
                         t->inside_range = false;
                         return TR_FOUND;
                 }
         }
 }
 
-static void
-tr_table_set(unsigned int *table, unichar c, unsigned int value)
+/* {{{1
+ * Return the next character or range of characters of ‘t’ as the inclusive
+ * range from ‘begin’ to ‘end’, without stepping through the range.
+ */
+enum tr_state
+tr_next_range(struct tr *t, unichar *begin, unichar *end)
 {
-        unsigned int offset = c / WORD_BIT;
-        unsigned int bit = c % WORD_BIT;
+        enum tr_state state = tr_next(t);
+        if (state != TR_FOUND)
+                return state;
 
-        table[offset] = (table[offset] & ~(1U << bit)) | ((value & 1U) << bit);
+        *begin = t->now;
+        if (t->inside_range) {
+                t->now = t->max;
+                t->inside_range = false;
+        }
+        *end = t->now;
+
+        return state;
 }
 
-void
-tr_setup_table(VALUE str, unsigned int *table, bool initialize)
+static int
+tr_range_compare(const void *a, const void *b)
+{
+        unichar a_begin = ((const struct tr_range *)a)->begin;
+        unichar b_begin = ((const struct tr_range *)b)->begin;
+
+        return (a_begin < b_begin) ? -1 : (a_begin > b_begin);
+}
+
+/* {{{1
+ * Sort ‘ranges’ and merge those that overlap or are adjacent, returning how
+ * many remain.
+ */
+static long
+tr_ranges_normalize(struct tr_range *ranges, long n)
+{
+        if (n == 0)
+                return 0;
+
+        qsort(ranges, n, sizeof(struct tr_range), tr_range_compare);
+
+        long m = 0;
+        for (long i = 1; i < n; i++) {
+                if (ranges[i].begin <= ranges[m].end + 1) {
+                        if (ranges[i].end > ranges[m].end)
+                                ranges[m].end = ranges[i].end;
+                } else {
+                        ranges[++m] = ranges[i];
+                }
+        }
+
+        return m + 1;
+}
+
+/* {{{1
+ * Replace the ‘n’ sorted and disjoint ranges in ‘ranges’, which must have
+ * room for one more, by the gaps between them, returning how many there
+ * are.  The gaps are computed from the last one to the first, so that every
+ * range has been used by the time that its slot is overwritten.
+ */
+static long
+tr_ranges_complement(struct tr_range *ranges, long n)
 {
-        unsigned int buf[TR_TABLE_SIZE];
+        unichar end = UNICODE_N_CODEPOINTS - 1;
+
+        for (long i = n; i >= 0; i--) {
+                struct tr_range gap;
+                gap.begin = (i > 0) ? ranges[i - 1].end + 1 : 0;
+                gap.end = (i < n) ? ranges[i].begin - 1 : end;
+                ranges[i] = gap;
+        }
+
+        long m = 0;
+        for (long i = 0; i <= n; i++)
+                if (ranges[i].begin <= ranges[i].end &&
+                    ranges[i].end != (unichar)-1)
+                        ranges[m++] = ranges[i];
+
+        return m;
+}
 
+/* {{{1
+ * Parse the specification ‘str’ into sorted and disjoint ranges, stored in
+ * ‘ranges’, which must have room for RSTRING(str)->len + 1 of them, returning
+ * how many there are.
+ */
+static long
+tr_ranges_parse(VALUE str, struct tr_range *ranges)
+{
         struct tr tr;
         tr_init(&tr, RSTRING(str)->ptr, RSTRING(str)->ptr + RSTRING(str)->len);
 
         bool exclude = tr_should_exclude(&tr);
 
-        if (initialize)
-                for (int i = 0; i < TR_TABLE_SIZE; i++)
-                        table[i] = ~0U;
+        long n = 0;
+        unichar begin, end;
+        while (tr_next_range(&tr, &begin, &end) != TR_FINISHED) {
+                ranges[n].begin = begin;
+                ranges[n].end = (end < UNICODE_N_CODEPOINTS) ?
+                        end : UNICODE_N_CODEPOINTS - 1;
+                n++;
+        }
+
+        n = tr_ranges_normalize(ranges, n);
+        if (exclude)
+                n = tr_ranges_complement(ranges, n);
+
+        return n;
+}
+
+/* {{{1
+ * Store the intersection of the sorted and disjoint ranges ‘a’ and ‘b’ in
+ * ‘result’, which must have room for ‘n_a’ + ‘n_b’ ranges, returning how
+ * many there are.
+ */
+static long
+tr_ranges_intersect(const struct tr_range *a, long n_a,
+                    const struct tr_range *b, long n_b,
+                    struct tr_range *result)
+{
+        long n = 0;
+
+        for (long i = 0, j = 0; i < n_a && j < n_b; ) {
+                unichar begin = (a[i].begin > b[j].begin) ? a[i].begin : b[j].begin;
+                unichar end = (a[i].end < b[j].end) ? a[i].end : b[j].end;
+                if (begin <= end) {
+                        result[n].begin = begin;
+                        result[n].end = end;
+                        n++;
+                }
+
+                if (a[i].end < b[j].end)
+                        i++;
+                else
+                        j++;
+        }
+
+        return n;
+}
+
+/* {{{1
+ * A small cache of parsed specifications, so that a specification that is
+ * used over and over again, like the "^a-zA-Z0-9" of a loop that strips
+ * everything but letters and digits, is only parsed once.  The cache is
+ * direct-mapped on a hash of the specification, so a new specification
+ * simply replaces the one that was there before it.  Specifications longer
+ * than TR_CACHE_MAX_LENGTH bytes are parsed every time, so that the cache
+ * never holds on to more than a few kilobytes.  The specification of an
+ * entry is stored right after its ranges, so that both are allocated at
+ * once and neither can leak if the allocation fails.
+ */
+#define TR_CACHE_SIZE 64
+#define TR_CACHE_MAX_LENGTH 64
+
+struct tr_cache_entry
+{
+        uint64_t hash;
+        char *spec;
+        long len;
+        struct tr_range *ranges;
+        long n_ranges;
+};
+
+static struct tr_cache_entry tr_cache[TR_CACHE_SIZE];
+
+/* {{{1
+ * Return room for ‘n’ ranges in a new string stored in ‘storage’, which is
+ * left for the garbage collector to free, so that nothing leaks if an
+ * exception is raised before they’re done with.
+ */
+static struct tr_range *
+tr_ranges_storage_new(long n, volatile VALUE *storage)
+{
+        *storage = rb_str_buf_new(n * sizeof(struct tr_range));
+
+        return (struct tr_range *)RSTRING(*storage)->ptr;
+}
+
+/* {{{1
+ * Return the ranges of the specification ‘str’, parsing it into ‘storage’
+ * and storing the result in the cache unless it’s already there or too long
+ * to be cached.  The ranges are only valid until the next lookup.
+ */
+static long
+tr_cache_lookup(VALUE str, const struct tr_range **ranges,
+                volatile VALUE *storage)
+{
+        const char *s = RSTRING(str)->ptr;
+        long len = RSTRING(str)->len;
+
+        if (len > TR_CACHE_MAX_LENGTH) {
+                struct tr_range *parsed = tr_ranges_storage_new(len + 1, storage);
+                *ranges = parsed;
+                return tr_ranges_parse(str, parsed);
+        }
+
+        uint64_t hash = fnv1a_64(FNV_OFFSET_BASIS_64, s, len);
+        struct tr_cache_entry *entry = &tr_cache[hash % TR_CACHE_SIZE];
+
+        if (entry->spec == NULL || entry->hash != hash || entry->len != len ||
+            memcmp(entry->spec, s, len) != 0) {
+                struct tr_range *parsed = tr_ranges_storage_new(len + 1, storage);
+                long n = tr_ranges_parse(str, parsed);
+
+                struct tr_range *copy =
+                        (struct tr_range *)ALLOC_N(char, (n + 1) *
+                                                   sizeof(struct tr_range) +
+                                                   len + 1);
+                memcpy(copy, parsed, n * sizeof(struct tr_range));
+                char *spec = (char *)(copy + n + 1);
+                memcpy(spec, s, len);
+
+                free(entry->ranges);
+                entry->hash = hash;
+                entry->spec = spec;
+                entry->len = len;
+                entry->ranges = copy;
+                entry->n_ranges = n;
+        }
+
+        *ranges = entry->ranges;
+        return entry->n_ranges;
+}
+
+/* {{{1
+ * Return how many ranges a set made from the specifications in ‘argv’ may
+ * need at most, converting those that aren’t CharSets to strings.
+ */
+static long
+tr_set_max_ranges(int argc, VALUE *argv)
+{
+        long n = 1;
+
+        for (int i = 0; i < argc; i++) {
+                const struct tr_set *charset = rb_utf_charset_get_set(argv[i]);
+
+                if (charset != NULL) {
+                        n += charset->n_ranges;
+                } else {
+                        StringValue(argv[i]);
+                        n += RSTRING(argv[i])->len + 1;
+                }
+        }
+
+        return n;
+}
+
+/* {{{1
+ * Fill in the ASCII table of ‘set’ and point it at the ‘n’ sorted and
+ * disjoint ranges in ‘ranges’.
+ */
+static void
+tr_set_index(struct tr_set *set, const struct tr_range *ranges, long n)
+{
+        memset(set->ascii, 0, sizeof(set->ascii));
+
+        long i = 0;
+        for (; i < n && ranges[i].end < 0x80; i++)
+                for (unichar c = ranges[i].begin; c <= ranges[i].end; c++)
+                        set->ascii[c] = true;
+        if (i < n)
+                for (unichar c = ranges[i].begin; c < 0x80; c++)
+                        set->ascii[c] = true;
+
+        set->ranges = ranges;
+        set->n_ranges = n;
+        set->non_ascii = i;
+}
+
+/* {{{1
+ * Set up ‘set’ to contain the characters that are included by all the
+ * specifications in ‘argv’.  A specification may also be a CharSet, which
+ * is used as is if it’s the only one.  Each specification is intersected
+ * with the ranges found so far after moving them out of the way of the
+ * result, which never catches up with them, so no more room than
+ * tr_set_max_ranges() is needed.
+ */
+void
+tr_set_init(struct tr_set *set, int argc, VALUE *argv)
+{
+        const struct tr_set *charset;
+
+        set->storage = Qnil;
+        if (argc == 1 && (charset = rb_utf_charset_get_set(argv[0])) != NULL) {
+                set->ranges = charset->ranges;
+                set->n_ranges = charset->n_ranges;
+                set->non_ascii = charset->non_ascii;
+                memcpy(set->ascii, charset->ascii, sizeof(set->ascii));
+                return;
+        }
+
+        long max = tr_set_max_ranges(argc, argv);
+        struct tr_range *ranges = set->buffer;
+        if (max > TR_SET_BUFFER_SIZE)
+                ranges = tr_ranges_storage_new(max, &set->storage);
+
+        volatile VALUE parsed = Qnil;
+        long n = 1;
+        ranges[0].begin = 0;
+        ranges[0].end = UNICODE_N_CODEPOINTS - 1;
+
+        for (int i = 0; i < argc; i++) {
+                const struct tr_range *spec;
+                long n_spec;
+
+                if ((charset = rb_utf_charset_get_set(argv[i])) != NULL) {
+                        spec = charset->ranges;
+                        n_spec = charset->n_ranges;
+                } else {
+                        VALUE s = argv[i];
 
-        unsigned int buf_initializer = exclude ? ~0U : 0U;
-        for (int i = 0; i < TR_TABLE_SIZE; i++)
-                buf[i] = buf_initializer;
+                        StringValue(s);
+                        n_spec = tr_cache_lookup(s, &spec, &parsed);
+                }
 
-        unsigned int buf_setter = !exclude;
-        while (tr_next(&tr) != TR_FINISHED)
-                tr_table_set(buf, tr.now, buf_setter);
+                memmove(ranges + n_spec, ranges, n * sizeof(struct tr_range));
+                n = tr_ranges_intersect(ranges + n_spec, n, spec, n_spec,
+                                        ranges);
+        }
 
-        for (int i = 0; i < TR_TABLE_SIZE; i++)
-                table[i] &= buf[i];
+        tr_set_index(set, ranges, n);
 }
 
+/* {{{1
+ * Set up ‘set’ to contain all characters.
+ */
 void
-tr_setup_table_from_strings(unsigned int *table, int argc, VALUE *argv)
+tr_set_init_all(struct tr_set *set)
 {
-    bool initialize = true;
-    for (int i = 0; i < argc; i++) {
-            VALUE s = argv[i];
+        static const struct tr_range all = { 0, UNICODE_N_CODEPOINTS - 1 };
 
-            StringValue(s);
-            tr_setup_table(s, table, initialize);
-            initialize = false;
-    }
+        set->storage = Qnil;
+        tr_set_index(set, &all, 1);
 }
 
+/* {{{1
+ * Check whether the non-ASCII character ‘c’ is in ‘set’ by binary search
+ * over its ranges.
+ */
+bool
+tr_set_contains_non_ascii(const struct tr_set *set, unichar c)
+{
+        long low = set->non_ascii;
+        long high = set->n_ranges;
+
+        while (low < high) {
+                long middle = low + (high - low) / 2;
+
+                if (c < set->ranges[middle].begin)
+                        high = middle;
+                else if (c > set->ranges[middle].end)
+                        low = middle + 1;
+                else
+                        return true;
+        }
+
+        return false;
+}
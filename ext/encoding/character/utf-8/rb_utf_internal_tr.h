@@ -7,15 +7,6 @@
 #ifndef TR_H
 #define TR_H
 
-#ifndef WORD_BIT
-#  define WORD_BIT              (sizeof(int) * CHAR_BIT)
-#endif
-
-#define TR_TABLE_SIZE           ((int)(UNICODE_N_CODEPOINTS / WORD_BIT))
-
-#define tr_table_lookup(table, offset)       \
-        ((table)[(offset) / WORD_BIT] & (1U << (offset) % WORD_BIT))
-
 struct tr {
         bool inside_range;
         unichar now;
@@ -31,11 +22,49 @@ enum tr_state
         TR_FINISHED
 };
 
+struct tr_range
+{
+        unichar begin;
+        unichar end;
+};
+
+/*
+ * A set of characters, as given by one or more specifications like those of
+ * String#count.  ASCII characters are looked up in a table and the rest in
+ * sorted, disjoint ranges, so that setting one up takes time and space
+ * proportional to the length of its specifications.  ‘ranges’ covers all
+ * the characters of the set, starting with those that are ASCII, and
+ * ‘non_ascii’ is the index of the first range that reaches beyond them.
+ * The ranges are stored in ‘buffer’ if there’s room for them, and otherwise
+ * in the string ‘storage’, which is left for the garbage collector to free
+ * once the set goes out of scope, even if an exception is raised.
+ */
+#define TR_SET_BUFFER_SIZE 32
+
+struct tr_set
+{
+        bool ascii[0x80];
+        const struct tr_range *ranges;
+        long n_ranges;
+        long non_ascii;
+        struct tr_range buffer[TR_SET_BUFFER_SIZE];
+        VALUE storage;
+};
+
+#define tr_set_contains(set, c)                         \
+        (((c) < 0x80) ?                                 \
+         (set)->ascii[(c)] :                            \
+         tr_set_contains_non_ascii((set), (c)))
+
 void tr_init(struct tr *tr, char *p, char *p_end) HIDDEN;
 bool tr_should_exclude(struct tr *tr) HIDDEN;
 enum tr_state tr_next(struct tr *t) HIDDEN;
-void tr_setup_table(VALUE str, unsigned int *table, bool initialize) HIDDEN;
-void tr_setup_table_from_strings(unsigned int *table, int argc,
-                                 VALUE *argv) HIDDEN;
+enum tr_state tr_next_range(struct tr *t, unichar *begin, unichar *end) HIDDEN;
+void tr_set_init(struct tr_set *set, int argc, VALUE *argv) HIDDEN;
+void tr_set_init_all(struct tr_set *set) HIDDEN;
+bool tr_set_contains_non_ascii(const struct tr_set *set, unichar c) HIDDEN;
+
+const struct tr_set *rb_utf_charset_get_set(VALUE obj) HIDDEN;
+VALUE rb_utf_charset_get_spec(VALUE charset) HIDDEN;
 
 #endif /* TR_H */
@@ -0,0 +1,23 @@
+/*
+ * contents: UTF8.natural_compare module function.
+ *
+ * Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+ */
+
+#include "rb_includes.h"
+
+VALUE
+rb_utf_natural_compare(int argc, VALUE *argv, UNUSED(VALUE self))
+{
+        VALUE str1, str2, fold;
+
+        rb_scan_args(argc, argv, "21", &str1, &str2, &fold);
+        StringValue(str1);
+        StringValue(str2);
+
+        return INT2FIX(utf_natural_compare_n(RSTRING(str1)->ptr,
+                                             RSTRING(str1)->len,
+                                             RSTRING(str2)->ptr,
+                                             RSTRING(str2)->len,
+                                             RTEST(fold)));
+}
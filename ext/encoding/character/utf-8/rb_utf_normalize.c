@@ -1,5 +1,5 @@
 /*
- * contents: Encoding::Character::UTF8.normalize module function.
+ * contents: Encoding::Character::UTF8.normalize module functions.
  *
  * Copyright © 2006 Nikolai Weibull <now@bitwi.se>
  */
@@ -14,8 +14,8 @@
                 return mode;                            \
 } while (0)
 
-static NormalizeMode
-symbol_to_mode(VALUE symbol)
+NormalizeMode
+rb_utf_symbol_to_normalize_mode(VALUE symbol)
 {
         if (!SYMBOL_P(symbol))
                 rb_raise(rb_eTypeError, "not a symbol");
@@ -30,6 +30,7 @@ symbol_to_mode(VALUE symbol)
         SYMBOL2MODE(nfkd, NORMALIZE_NFKD, id);
         SYMBOL2MODE(all_compose, NORMALIZE_ALL_COMPOSE, id);
         SYMBOL2MODE(nfkc, NORMALIZE_NFKC, id);
+        SYMBOL2MODE(nfkc_casefold, NORMALIZE_NFKC_CASEFOLD, id);
 
         rb_raise(rb_eArgError, "unknown symbol");
 }
@@ -41,7 +42,7 @@ rb_utf_normalize(int argc, VALUE *argv, UNUSED(VALUE self))
 
         NormalizeMode mode = NORMALIZE_DEFAULT;
         if (rb_scan_args(argc, argv, "11", &str, &rbmode) == 2)
-                mode = symbol_to_mode(rbmode);
+                mode = rb_utf_symbol_to_normalize_mode(rbmode);
 
         StringValue(str);
 
@@ -49,3 +50,65 @@ rb_utf_normalize(int argc, VALUE *argv, UNUSED(VALUE self))
                                                   mode,
                                                   RSTRING(str)->len));
 }
+
+VALUE
+rb_utf_normalize_bang(int argc, VALUE *argv, UNUSED(VALUE self))
+{
+        VALUE str, rbmode;
+
+        NormalizeMode mode = NORMALIZE_DEFAULT;
+        if (rb_scan_args(argc, argv, "11", &str, &rbmode) == 2)
+                mode = rb_utf_symbol_to_normalize_mode(rbmode);
+
+        StringValue(str);
+        if (utf_normalize_quick_check_n(RSTRING(str)->ptr, mode,
+                                        RSTRING(str)->len) ==
+            UNICODE_QUICK_CHECK_YES)
+                return Qnil;
+
+        rb_str_modify(str);
+
+        size_t len = RSTRING(str)->len;
+        bool changed;
+        char *normalized = utf_normalize_in_place(RSTRING(str)->ptr, &len,
+                                                  mode, &changed);
+        if (normalized != RSTRING(str)->ptr) {
+                rb_str_resize(str, len);
+                memcpy(RSTRING(str)->ptr, normalized, len);
+                free(normalized);
+        } else {
+                RSTRING(str)->len = len;
+        }
+
+        return changed ? str : Qnil;
+}
+
+VALUE
+rb_utf_nfkc_casefold(UNUSED(VALUE self), VALUE str)
+{
+        StringValue(str);
+        if (utf_normalize_quick_check_n(RSTRING(str)->ptr,
+                                        NORMALIZE_NFKC_CASEFOLD,
+                                        RSTRING(str)->len) ==
+            UNICODE_QUICK_CHECK_YES)
+                return rb_utf_dup(str);
+
+        return rb_utf_alloc_using(utf_normalize_n(RSTRING(str)->ptr,
+                                                  NORMALIZE_NFKC_CASEFOLD,
+                                                  RSTRING(str)->len));
+}
+
+VALUE
+rb_utf_normalized_p(int argc, VALUE *argv, UNUSED(VALUE self))
+{
+        VALUE str, rbmode;
+
+        NormalizeMode mode = NORMALIZE_DEFAULT;
+        if (rb_scan_args(argc, argv, "11", &str, &rbmode) == 2)
+                mode = rb_utf_symbol_to_normalize_mode(rbmode);
+
+        StringValue(str);
+
+        return utf_is_normalized_n(RSTRING(str)->ptr, mode,
+                                   RSTRING(str)->len) ? Qtrue : Qfalse;
+}
@@ -0,0 +1,306 @@
+/*
+ * contents: Encoding::Character::UTF8::NormalizeCache class.
+ *
+ * Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+ */
+
+#include "rb_includes.h"
+
+#define NORMALIZE_CACHE_DEFAULT_CAPACITY 4096
+
+
+/* {{{1
+ * A NormalizeCache remembers the normalized forms of the last ‘capacity’
+ * strings it was asked to normalize.  Entries are kept in a hash table keyed
+ * by the input bytes and the normalization mode, and in a list ordered by
+ * when they were last used, so that the least recently used entry can be
+ * reused once the cache is full.  Both the input and its normalized form are
+ * stored as frozen strings, so a hit can return the same string every time.
+ */
+typedef struct _NormalizeCacheEntry NormalizeCacheEntry;
+
+struct _NormalizeCacheEntry {
+        NormalizeCacheEntry *chain;
+        NormalizeCacheEntry *older;
+        NormalizeCacheEntry *newer;
+        uint64_t hash;
+        NormalizeMode mode;
+        VALUE str;
+        VALUE normalized;
+};
+
+typedef struct _NormalizeCache NormalizeCache;
+
+struct _NormalizeCache {
+        NormalizeCacheEntry **buckets;
+        size_t n_buckets;
+        NormalizeCacheEntry *newest;
+        NormalizeCacheEntry *oldest;
+        size_t size;
+        size_t capacity;
+        unsigned long hits;
+        unsigned long misses;
+};
+
+static uint64_t
+normalize_cache_hash(const char *str, size_t len, NormalizeMode mode)
+{
+        return fnv1a_64((FNV_OFFSET_BASIS_64 ^ mode) * FNV_PRIME_64, str, len);
+}
+
+static void
+normalize_cache_mark(NormalizeCache *cache)
+{
+        for (NormalizeCacheEntry *entry = cache->newest; entry != NULL;
+             entry = entry->older) {
+                rb_gc_mark(entry->str);
+                rb_gc_mark(entry->normalized);
+        }
+}
+
+static void
+normalize_cache_clear(NormalizeCache *cache)
+{
+        NormalizeCacheEntry *entry = cache->newest;
+        while (entry != NULL) {
+                NormalizeCacheEntry *older = entry->older;
+                free(entry);
+                entry = older;
+        }
+
+        if (cache->buckets != NULL)
+                memset(cache->buckets, 0,
+                       cache->n_buckets * sizeof(NormalizeCacheEntry *));
+        cache->newest = cache->oldest = NULL;
+        cache->size = 0;
+}
+
+static void
+normalize_cache_free(NormalizeCache *cache)
+{
+        normalize_cache_clear(cache);
+        free(cache->buckets);
+        free(cache);
+}
+
+static VALUE
+rb_utf_normalize_cache_alloc(VALUE klass)
+{
+        NormalizeCache *cache;
+
+        return Data_Make_Struct(klass, NormalizeCache, normalize_cache_mark,
+                                normalize_cache_free, cache);
+}
+
+static NormalizeCache *
+rb_utf_normalize_cache_get(VALUE self)
+{
+        NormalizeCache *cache;
+
+        Data_Get_Struct(self, NormalizeCache, cache);
+        if (cache->buckets == NULL)
+                rb_raise(rb_eArgError, "uninitialized normalize cache");
+
+        return cache;
+}
+
+/* {{{1
+ * Unlink ‘entry’ from the list of entries ordered by use.
+ */
+static void
+normalize_cache_unlink(NormalizeCache *cache, NormalizeCacheEntry *entry)
+{
+        if (entry->newer != NULL)
+                entry->newer->older = entry->older;
+        else
+                cache->newest = entry->older;
+
+        if (entry->older != NULL)
+                entry->older->newer = entry->newer;
+        else
+                cache->oldest = entry->newer;
+}
+
+/* {{{1
+ * Make ‘entry’ the most recently used entry.
+ */
+static void
+normalize_cache_push(NormalizeCache *cache, NormalizeCacheEntry *entry)
+{
+        entry->newer = NULL;
+        entry->older = cache->newest;
+        if (cache->newest != NULL)
+                cache->newest->newer = entry;
+        else
+                cache->oldest = entry;
+        cache->newest = entry;
+}
+
+/* {{{1
+ * Remove the least recently used entry from the cache and return it, so that
+ * it can be reused.
+ */
+static NormalizeCacheEntry *
+normalize_cache_evict(NormalizeCache *cache)
+{
+        NormalizeCacheEntry *entry = cache->oldest;
+
+        NormalizeCacheEntry **link =
+                &cache->buckets[entry->hash & (cache->n_buckets - 1)];
+        while (*link != entry)
+                link = &(*link)->chain;
+        *link = entry->chain;
+
+        normalize_cache_unlink(cache, entry);
+        cache->size--;
+
+        return entry;
+}
+
+static VALUE
+rb_utf_normalize_cache_initialize(int argc, VALUE *argv, VALUE self)
+{
+        VALUE rbcapacity;
+        NormalizeCache *cache;
+
+        Data_Get_Struct(self, NormalizeCache, cache);
+
+        long capacity = NORMALIZE_CACHE_DEFAULT_CAPACITY;
+        if (rb_scan_args(argc, argv, "01", &rbcapacity) == 1)
+                capacity = NUM2LONG(rbcapacity);
+        if (capacity <= 0)
+                rb_raise(rb_eArgError, "capacity must be positive: %ld",
+                         capacity);
+
+        size_t n_buckets = 1;
+        while (n_buckets < (size_t)capacity)
+                n_buckets <<= 1;
+
+        normalize_cache_clear(cache);
+        free(cache->buckets);
+        cache->buckets = NULL;
+        NormalizeCacheEntry **buckets = ALLOC_N(NormalizeCacheEntry *,
+                                                n_buckets);
+        memset(buckets, 0, n_buckets * sizeof(NormalizeCacheEntry *));
+        cache->buckets = buckets;
+        cache->n_buckets = n_buckets;
+        cache->capacity = capacity;
+        cache->hits = cache->misses = 0;
+
+        return self;
+}
+
+/* {{{1
+ * Return the normalized form of ‘str’ as a frozen string, looking it up in
+ * the cache first.  If ‘str’ is already normalized, the frozen copy of it
+ * that is used as the key is returned.
+ */
+static VALUE
+rb_utf_normalize_cache_normalize(int argc, VALUE *argv, VALUE self)
+{
+        VALUE str, rbmode;
+        NormalizeCache *cache = rb_utf_normalize_cache_get(self);
+
+        NormalizeMode mode = NORMALIZE_DEFAULT;
+        if (rb_scan_args(argc, argv, "11", &str, &rbmode) == 2)
+                mode = rb_utf_symbol_to_normalize_mode(rbmode);
+
+        StringValue(str);
+        const char *s = RSTRING(str)->ptr;
+        long len = RSTRING(str)->len;
+
+        uint64_t hash = normalize_cache_hash(s, len, mode);
+        for (NormalizeCacheEntry *entry =
+                cache->buckets[hash & (cache->n_buckets - 1)];
+             entry != NULL; entry = entry->chain) {
+                if (entry->hash == hash && entry->mode == mode &&
+                    RSTRING(entry->str)->len == len &&
+                    memcmp(RSTRING(entry->str)->ptr, s, len) == 0) {
+                        normalize_cache_unlink(cache, entry);
+                        normalize_cache_push(cache, entry);
+                        cache->hits++;
+                        return entry->normalized;
+                }
+        }
+
+        cache->misses++;
+
+        VALUE key = rb_obj_freeze(rb_utf_new(s, len));
+        VALUE normalized = key;
+        if (utf_normalize_quick_check_n(s, mode, len) !=
+            UNICODE_QUICK_CHECK_YES) {
+                char *n = utf_normalize_n(s, mode, len);
+                normalized = rb_obj_freeze(rb_utf_alloc_using(n));
+        }
+
+        NormalizeCacheEntry *entry = (cache->size == cache->capacity) ?
+                normalize_cache_evict(cache) :
+                ALLOC(NormalizeCacheEntry);
+        NormalizeCacheEntry **bucket =
+                &cache->buckets[hash & (cache->n_buckets - 1)];
+        entry->hash = hash;
+        entry->mode = mode;
+        entry->str = key;
+        entry->normalized = normalized;
+        entry->chain = *bucket;
+        *bucket = entry;
+        normalize_cache_push(cache, entry);
+        cache->size++;
+
+        return normalized;
+}
+
+static VALUE
+rb_utf_normalize_cache_clear(VALUE self)
+{
+        normalize_cache_clear(rb_utf_normalize_cache_get(self));
+
+        return self;
+}
+
+static VALUE
+rb_utf_normalize_cache_size(VALUE self)
+{
+        return ULONG2NUM(rb_utf_normalize_cache_get(self)->size);
+}
+
+static VALUE
+rb_utf_normalize_cache_capacity(VALUE self)
+{
+        return ULONG2NUM(rb_utf_normalize_cache_get(self)->capacity);
+}
+
+static VALUE
+rb_utf_normalize_cache_hits(VALUE self)
+{
+        return ULONG2NUM(rb_utf_normalize_cache_get(self)->hits);
+}
+
+static VALUE
+rb_utf_normalize_cache_misses(VALUE self)
+{
+        return ULONG2NUM(rb_utf_normalize_cache_get(self)->misses);
+}
+
+void
+Init_utf8_normalize_cache(VALUE mUTF8)
+{
+        VALUE cNormalizeCache = rb_define_class_under(mUTF8, "NormalizeCache",
+                                                      rb_cObject);
+
+        rb_define_alloc_func(cNormalizeCache, rb_utf_normalize_cache_alloc);
+        rb_define_method(cNormalizeCache, "initialize",
+                         rb_utf_normalize_cache_initialize, -1);
+        rb_define_method(cNormalizeCache, "normalize",
+                         rb_utf_normalize_cache_normalize, -1);
+        rb_define_method(cNormalizeCache, "clear",
+                         rb_utf_normalize_cache_clear, 0);
+        rb_define_method(cNormalizeCache, "size",
+                         rb_utf_normalize_cache_size, 0);
+        rb_define_method(cNormalizeCache, "capacity",
+                         rb_utf_normalize_cache_capacity, 0);
+        rb_define_method(cNormalizeCache, "hits",
+                         rb_utf_normalize_cache_hits, 0);
+        rb_define_method(cNormalizeCache, "misses",
+                         rb_utf_normalize_cache_misses, 0);
+}
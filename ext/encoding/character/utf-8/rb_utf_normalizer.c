@@ -0,0 +1,86 @@
+/*
+ * contents: Encoding::Character::UTF8::Normalizer class.
+ *
+ * Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+ */
+
+#include "rb_includes.h"
+
+static void
+rb_utf_normalizer_free(UTFNormalizer *normalizer)
+{
+        if (normalizer != NULL)
+                utf_normalizer_free(normalizer);
+}
+
+static VALUE
+rb_utf_normalizer_alloc(VALUE klass)
+{
+        return Data_Wrap_Struct(klass, NULL, rb_utf_normalizer_free, NULL);
+}
+
+static UTFNormalizer *
+rb_utf_normalizer_get(VALUE self)
+{
+        UTFNormalizer *normalizer;
+
+        Data_Get_Struct(self, UTFNormalizer, normalizer);
+        if (normalizer == NULL)
+                rb_raise(rb_eArgError, "uninitialized normalizer");
+
+        return normalizer;
+}
+
+static VALUE
+rb_utf_normalizer_initialize(int argc, VALUE *argv, VALUE self)
+{
+        VALUE rbmode;
+
+        NormalizeMode mode = NORMALIZE_DEFAULT;
+        if (rb_scan_args(argc, argv, "01", &rbmode) == 1)
+                mode = rb_utf_symbol_to_normalize_mode(rbmode);
+
+        rb_utf_normalizer_free(DATA_PTR(self));
+        DATA_PTR(self) = utf_normalizer_new(mode);
+
+        return self;
+}
+
+static VALUE
+rb_utf_normalizer_feed(VALUE self, VALUE str)
+{
+        UTFNormalizer *normalizer = rb_utf_normalizer_get(self);
+
+        StringValue(str);
+
+        size_t len;
+        char *result = utf_normalizer_feed(normalizer, RSTRING(str)->ptr,
+                                           RSTRING(str)->len, &len);
+
+        return rb_utf_alloc_using_n(result, len);
+}
+
+static VALUE
+rb_utf_normalizer_finish(VALUE self)
+{
+        size_t len;
+        char *result = utf_normalizer_finish(rb_utf_normalizer_get(self), &len);
+        if (result == NULL)
+                rb_raise(rb_eArgError,
+                         "input ends with an incomplete UTF-8-encoded character");
+
+        return rb_utf_alloc_using_n(result, len);
+}
+
+void
+Init_utf8_normalizer(VALUE mUTF8)
+{
+        VALUE cNormalizer = rb_define_class_under(mUTF8, "Normalizer",
+                                                  rb_cObject);
+
+        rb_define_alloc_func(cNormalizer, rb_utf_normalizer_alloc);
+        rb_define_method(cNormalizer, "initialize",
+                         rb_utf_normalizer_initialize, -1);
+        rb_define_method(cNormalizer, "feed", rb_utf_normalizer_feed, 1);
+        rb_define_method(cNormalizer, "finish", rb_utf_normalizer_finish, 0);
+}
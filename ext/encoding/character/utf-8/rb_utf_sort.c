@@ -0,0 +1,92 @@
+/*
+ * contents: UTF8.sort and UTF8.sort_by_collation! module functions.
+ *
+ * Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+ */
+
+#include "rb_includes.h"
+
+typedef struct _SortArguments SortArguments;
+
+struct _SortArguments {
+        const UTFCollator *collator;
+        VALUE elements;
+        VALUE strs;
+        CollateSortKey *keys;
+        long n;
+};
+
+static VALUE
+rb_utf_sort_run(VALUE closure)
+{
+        SortArguments *args = (SortArguments *)closure;
+
+        collate_sort_keys(args->collator, args->keys, args->n);
+
+        VALUE sorted = rb_ary_new2(args->n);
+        for (long i = 0; i < args->n; i++)
+                rb_ary_push(sorted,
+                            RARRAY(args->elements)->ptr[args->keys[i].index]);
+
+        return sorted;
+}
+
+static VALUE
+rb_utf_sort_free(VALUE closure)
+{
+        SortArguments *args = (SortArguments *)closure;
+
+        for (long i = 0; i < args->n; i++)
+                free(args->keys[i].key);
+        free(args->keys);
+
+        return Qnil;
+}
+
+/* {{{1
+ * Return a new array with the elements of ‘ary’ sorted by collation with
+ * ‘collator’, or the DUCET if it’s NULL.  Each element is converted to a
+ * string and given a sort key once, instead of being collated with others
+ * O(n log n) times.
+ */
+VALUE
+rb_utf_sort_array(const UTFCollator *collator, VALUE ary)
+{
+        SortArguments args;
+
+        Check_Type(ary, T_ARRAY);
+        args.collator = collator;
+        args.elements = rb_ary_dup(ary);
+        args.strs = rb_ary_dup(ary);
+        args.n = RARRAY(args.strs)->len;
+        for (long i = 0; i < args.n; i++) {
+                VALUE str = RARRAY(args.strs)->ptr[i];
+                StringValue(str);
+                RARRAY(args.strs)->ptr[i] = str;
+        }
+
+        args.keys = ALLOC_N(CollateSortKey, args.n);
+        for (long i = 0; i < args.n; i++) {
+                VALUE str = RARRAY(args.strs)->ptr[i];
+                args.keys[i].str = RSTRING(str)->ptr;
+                args.keys[i].len = RSTRING(str)->len;
+                args.keys[i].key = NULL;
+                args.keys[i].key_len = 0;
+                args.keys[i].index = i;
+        }
+
+        return rb_ensure(rb_utf_sort_run, (VALUE)&args,
+                         rb_utf_sort_free, (VALUE)&args);
+}
+
+VALUE
+rb_utf_sort(UNUSED(VALUE self), VALUE ary)
+{
+        return rb_utf_sort_array(NULL, ary);
+}
+
+VALUE
+rb_utf_sort_by_collation_bang(UNUSED(VALUE self), VALUE ary)
+{
+        return rb_ary_replace(ary, rb_utf_sort_array(NULL, ary));
+}
@@ -17,12 +17,11 @@ rb_utf_squeeze_bang(int argc, VALUE *argv, UNUSED(VALUE self))
         if (RSTRING(str)->len == 0)
                 return Qnil;
 
-        unsigned int table[TR_TABLE_SIZE];
+        struct tr_set set;
         if (argc == 1)
-                for (int i = 0; i < TR_TABLE_SIZE; i++)
-                        table[i] = ~0U;
+                tr_set_init_all(&set);
         else
-                tr_setup_table_from_strings(table, argc - 1, &argv[1]);
+                tr_set_init(&set, argc - 1, &argv[1]);
 
         rb_str_modify(str);
 
@@ -40,7 +39,7 @@ rb_utf_squeeze_bang(int argc, VALUE *argv, UNUSED(VALUE self))
                 unichar c = _utf_char_validated(s, end);
                 char *next = utf_next(s);
 
-                if (c != previous || !tr_table_lookup(table, c)) {
+                if (c != previous || !tr_set_contains(&set, c)) {
                         memmove(t, s, next - s);
                         t += next - s;
                         previous = c;
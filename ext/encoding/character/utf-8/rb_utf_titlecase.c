@@ -0,0 +1,16 @@
+/*
+ * contents: UTF8.titlecase module function.
+ *
+ * Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+ */
+
+#include "rb_includes.h"
+
+VALUE
+rb_utf_titlecase(UNUSED(VALUE self), VALUE str)
+{
+        StringValue(str);
+
+        return rb_utf_alloc_using(utf_titlecase_n(RSTRING(str)->ptr,
+                                                  RSTRING(str)->len));
+}
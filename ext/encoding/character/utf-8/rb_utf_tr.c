@@ -7,12 +7,6 @@
 #include "rb_includes.h"
 #include "rb_utf_internal_tr.h"
 
-struct tr_range
-{
-        unichar begin;
-        unichar end;
-};
-
 static int
 tr_ranges_setup(struct tr *tr, struct tr_range *ranges)
 {
@@ -86,7 +80,7 @@ tr_trans_replace_include(unichar c, void *v_closure)
 }
 
 static VALUE
-tr_trans_do(VALUE src, unsigned int *translation,
+tr_trans_do(VALUE src, const struct tr_set *translation,
             unichar (*replace)(unichar, void *), void *closure, bool squeeze,
             UNUSED(bool replace_content))
 {
@@ -116,7 +110,7 @@ again:
                         const char *prev = s;
                         s = utf_next(s);
 
-                        if (tr_table_lookup(translation, c0)) {
+                        if (tr_set_contains(translation, c0)) {
                                 unichar c = replace(c0, closure);
                                 if (prev_c == c)
                                         continue;
@@ -141,7 +135,7 @@ again:
                         const char *prev = s;
                         s = utf_next(s);
 
-                        if (tr_table_lookup(translation, c)) {
+                        if (tr_set_contains(translation, c)) {
                                 len += unichar_to_utf(replace(c, closure),
                                                       (t != NULL) ? t + len : NULL);
                                 modified = true;
@@ -185,7 +179,13 @@ static VALUE
 tr_trans(VALUE str, VALUE from, VALUE to, bool squeeze, bool replace_content)
 {
         StringValue(str);
-        StringValue(from);
+        VALUE from_spec;
+        if (rb_utf_charset_get_set(from) != NULL) {
+                from_spec = rb_utf_charset_get_spec(from);
+        } else {
+                StringValue(from);
+                from_spec = from;
+        }
         StringValue(to);
 
         if (RSTRING(str)->ptr == NULL || RSTRING(str)->len == 0)
@@ -195,28 +195,24 @@ tr_trans(VALUE str, VALUE from, VALUE to, bool squeeze, bool replace_content)
                 return rb_utf_delete_bang(1, &from, str);
 
         struct tr tr_from;
-        tr_init(&tr_from,
-                RSTRING(from)->ptr,
-                RSTRING(from)->ptr + RSTRING(from)->len);
-
         struct tr tr_to;
         tr_init(&tr_to,
                 RSTRING(to)->ptr,
                 RSTRING(to)->ptr + RSTRING(to)->len);
 
-        unsigned int translation[TR_TABLE_SIZE];
-        tr_setup_table(from, translation, true);
+        struct tr_set translation;
+        tr_set_init(&translation, 1, &from);
 
         tr_init(&tr_from,
-                RSTRING(from)->ptr,
-                RSTRING(from)->ptr + RSTRING(from)->len);
+                RSTRING(from_spec)->ptr,
+                RSTRING(from_spec)->ptr + RSTRING(from_spec)->len);
         if (tr_should_exclude(&tr_from)) {
                 /* This case is easy.  Just include everything by default and
                  * exclude the rest as always.  Replace characters found by the
                  * last character found in tr_to. */
                 while (tr_next(&tr_to) != TR_FINISHED)
                        ; /* We just need the last replacement character. */
-                return tr_trans_do(str, translation, tr_trans_replace_exclude,
+                return tr_trans_do(str, &translation, tr_trans_replace_exclude,
                                    &tr_to.now, squeeze, replace_content);
         } else {
                 /* This case is hard.  We need a full-fledged lookup of what
@@ -224,7 +220,7 @@ tr_trans(VALUE str, VALUE from, VALUE to, bool squeeze, bool replace_content)
                  * include it or not. */
                 struct tr_trans_closure trans_closure;
 
-                struct tr_range from_ranges[utf_length_n(RSTRING(from)->ptr, RSTRING(from)->len)];
+                struct tr_range from_ranges[utf_length_n(RSTRING(from_spec)->ptr, RSTRING(from_spec)->len)];
                 trans_closure.from = from_ranges;
                 trans_closure.n_from = tr_ranges_setup(&tr_from, from_ranges);
 
@@ -232,7 +228,7 @@ tr_trans(VALUE str, VALUE from, VALUE to, bool squeeze, bool replace_content)
                 trans_closure.to = to_ranges;
                 trans_closure.n_to = tr_ranges_setup(&tr_to, to_ranges);
 
-                return tr_trans_do(str, translation, tr_trans_replace_include,
+                return tr_trans_do(str, &translation, tr_trans_replace_include,
                                    &trans_closure, squeeze, replace_content);
         }
 }
@@ -206,9 +206,14 @@ rb_utf_new5(VALUE obj, const char *str, long len)
 
 VALUE
 rb_utf_alloc_using(char *str)
+{
+        return rb_utf_alloc_using_n(str, strlen(str));
+}
+
+VALUE
+rb_utf_alloc_using_n(char *str, long len)
 {
         VALUE rbstr = rb_utf_new(NULL, 0);
-        long len = strlen(str);
 
         RSTRING(rbstr)->ptr = str;
         RSTRING(rbstr)->aux.capa = len;
@@ -278,9 +283,22 @@ Init_utf8(void)
         mUTF8Methods = rb_define_module_under(mUTF8, "Methods");
 
         rb_define_module_function(mUTF8, "collate", rb_utf_collate, 2);
+        rb_define_module_function(mUTF8, "collate_key", rb_utf_collate_key, 1);
+        rb_define_module_function(mUTF8, "collate_key_prefix",
+                                  rb_utf_collate_key_prefix, 2);
+        rb_define_module_function(mUTF8, "collate_key_prefixes",
+                                  rb_utf_collate_key_prefixes, 2);
+        rb_define_module_function(mUTF8, "collate_prefix_bounds",
+                                  rb_utf_collate_prefix_bounds, 1);
+        rb_define_module_function(mUTF8, "sort", rb_utf_sort, 1);
+        rb_define_module_function(mUTF8, "sort_by_collation!",
+                                  rb_utf_sort_by_collation_bang, 1);
         rb_define_module_function(mUTF8, "aref", rb_utf_aref_m, -1);
         rb_define_module_function(mUTF8, "aset", rb_utf_aset_m, -1);
         rb_define_module_function(mUTF8, "casecmp", rb_utf_casecmp, 2);
+        rb_define_module_function(mUTF8, "casecmp?", rb_utf_casecmp_p, 2);
+        rb_define_module_function(mUTF8, "natural_compare",
+                                  rb_utf_natural_compare, -1);
         rb_define_module_function(mUTF8, "center", rb_utf_center, -1);
         rb_define_module_function(mUTF8, "chomp", rb_utf_chomp, -1);
         rb_define_module_function(mUTF8, "chomp!", rb_utf_chomp_bang, -1);
@@ -313,7 +331,18 @@ Init_utf8(void)
         rb_define_module_function(mUTF8, "reverse", rb_utf_reverse, 1);
         rb_define_module_function(mUTF8, "rjust", rb_utf_rjust, -1);
         rb_define_module_function(mUTF8, "upcase", rb_utf_upcase, 1);
+        rb_define_module_function(mUTF8, "capitalize", rb_utf_capitalize, 1);
+        rb_define_module_function(mUTF8, "titlecase", rb_utf_titlecase, 1);
 
         rb_define_module_function(mUTF8, "foldcase", rb_utf_foldcase, 1);
         rb_define_module_function(mUTF8, "normalize", rb_utf_normalize, -1);
+        rb_define_module_function(mUTF8, "normalize!", rb_utf_normalize_bang, -1);
+        rb_define_module_function(mUTF8, "normalized?", rb_utf_normalized_p, -1);
+        rb_define_module_function(mUTF8, "nfkc_casefold", rb_utf_nfkc_casefold, 1);
+        rb_define_module_function(mUTF8, "fold_hash", rb_utf_fold_hash, -1);
+
+        Init_utf8_normalizer(mUTF8);
+        Init_utf8_normalize_cache(mUTF8);
+        Init_utf8_collator(mUTF8);
+        Init_utf8_charset(mUTF8);
 }
@@ -145,7 +145,8 @@ typedef enum {
 	NORMALIZE_ALL,
 	NORMALIZE_NFKD = NORMALIZE_ALL,
 	NORMALIZE_ALL_COMPOSE,
-	NORMALIZE_NFKC = NORMALIZE_ALL_COMPOSE
+	NORMALIZE_NFKC = NORMALIZE_ALL_COMPOSE,
+	NORMALIZE_NFKC_CASEFOLD
 } NormalizeMode;
 
 void unicode_canonical_ordering(unichar *str, size_t len);
@@ -153,6 +154,34 @@ unichar *unicode_canonical_decomposition(unichar c, size_t *result_len);
 
 char *utf_normalize(const char *str, NormalizeMode mode);
 char *utf_normalize_n(const char *str, NormalizeMode mode, size_t len);
+char *utf_normalize_in_place(char *str, size_t *len, NormalizeMode mode, bool *changed);
+
+typedef enum {
+        UNICODE_QUICK_CHECK_YES,
+        UNICODE_QUICK_CHECK_NO,
+        UNICODE_QUICK_CHECK_MAYBE
+} UnicodeQuickCheck;
+
+UnicodeQuickCheck utf_normalize_quick_check(const char *str, NormalizeMode mode);
+UnicodeQuickCheck utf_normalize_quick_check_n(const char *str, NormalizeMode mode, size_t len);
+bool utf_is_normalized(const char *str, NormalizeMode mode);
+bool utf_is_normalized_n(const char *str, NormalizeMode mode, size_t len);
+
+typedef struct _UTFNormalizer UTFNormalizer;
+
+UTFNormalizer *utf_normalizer_new(NormalizeMode mode);
+void utf_normalizer_free(UTFNormalizer *normalizer);
+char *utf_normalizer_feed(UTFNormalizer *normalizer, const char *str, size_t len, size_t *new_len);
+char *utf_normalizer_finish(UTFNormalizer *normalizer, size_t *len);
+
+typedef enum {
+        FOLD_HASH_CASEFOLD,
+        FOLD_HASH_NFC,
+        FOLD_HASH_NFKC_CASEFOLD
+} FoldHashMode;
+
+uint64_t utf_fold_hash(const char *str, FoldHashMode mode);
+uint64_t utf_fold_hash_n(const char *str, size_t len, FoldHashMode mode);
 
 
 
@@ -161,8 +190,16 @@ char *utf_upcase(const char *str);
 char *utf_upcase_n(const char *str, size_t len);
 char *utf_downcase(const char *str);
 char *utf_downcase_n(const char *str, size_t len);
+char *utf_capitalize(const char *str);
+char *utf_capitalize_n(const char *str, size_t len);
+char *utf_titlecase(const char *str);
+char *utf_titlecase_n(const char *str, size_t len);
 char *utf_foldcase(const char *str);
 char *utf_foldcase_n(const char *str, size_t len);
+int utf_casecmp(const char *a, const char *b);
+int utf_casecmp_n(const char *a, size_t a_len, const char *b, size_t b_len);
+int utf_natural_compare(const char *a, const char *b, bool fold);
+int utf_natural_compare_n(const char *a, size_t a_len, const char *b, size_t b_len, bool fold);
 
 unichar utf_char(const char *str);
 unichar utf_char_n(const char *str, size_t max);
@@ -182,8 +219,33 @@ void utf_copy_n(char *dest, const char *src, size_t n);
 void utf_append(char *dest, const char *src);
 void utf_append_n(char *dest, const char *src, size_t n);
 int utf_collate(const char *a, const char *b);
-char *utf_collate_key(const char *str);
-char *utf_collate_key_n(const char *str, size_t len);
+int utf_collate_n(const char *a, size_t a_len, const char *b, size_t b_len);
+char *utf_collate_key(const char *str, size_t *key_len);
+char *utf_collate_key_n(const char *str, size_t len, size_t *key_len);
+void utf_collate_key_prefix(const char *str, char *prefix, size_t n);
+void utf_collate_key_prefix_n(const char *str, size_t len, char *prefix, size_t n);
+void utf_collate_prefix_bounds_n(const char *prefix, size_t len, char **lower, size_t *lower_len, char **upper, size_t *upper_len);
+
+typedef enum {
+        COLLATE_STRENGTH_PRIMARY = 1,
+        COLLATE_STRENGTH_SECONDARY,
+        COLLATE_STRENGTH_TERTIARY,
+        COLLATE_STRENGTH_QUATERNARY
+} CollateStrength;
+
+typedef enum {
+        COLLATE_CASE_FIRST_OFF,
+        COLLATE_CASE_FIRST_UPPER,
+        COLLATE_CASE_FIRST_LOWER
+} CollateCaseFirst;
+
+typedef struct _UTFCollator UTFCollator;
+
+UTFCollator *utf_collator_new(const char *locale, CollateStrength strength, bool numeric, CollateCaseFirst case_first);
+void utf_collator_free(UTFCollator *collator);
+int utf_collator_compare_n(const UTFCollator *collator, const char *a, size_t a_len, const char *b, size_t b_len);
+char *utf_collator_key_n(const UTFCollator *collator, const char *str, size_t len, size_t *key_len);
+void utf_collator_prefix_bounds_n(const UTFCollator *collator, const char *prefix, size_t len, char **lower, size_t *lower_len, char **upper, size_t *upper_len);
 int utf_char_index(const char *str, unichar c);
 int utf_char_index_n(const char *str, unichar c, size_t len);
 int utf_char_rindex(const char *str, unichar c);
@@ -18,6 +18,10 @@ module Encoding::Character::UTF8::Methods
     Encoding::Character::UTF8.collate(self, other)
   end
 
+  def collate_key
+    Encoding::Character::UTF8.collate_key(self)
+  end
+
   def [](*args)
     Encoding::Character::UTF8.aref(self, *args)
   end
@@ -34,6 +38,10 @@ module Encoding::Character::UTF8::Methods
     Encoding::Character::UTF8.casecmp(self, other)
   end
 
+  def casecmp?(other)
+    Encoding::Character::UTF8.casecmp?(self, other)
+  end
+
   def center(*args)
     Encoding::Character::UTF8.center(self, *args)
   end
@@ -95,10 +103,22 @@ module Encoding::Character::UTF8::Methods
     Encoding::Character::UTF8.lstrip!(self)
   end
 
+  def natural_compare(other, fold = false)
+    Encoding::Character::UTF8.natural_compare(self, other, fold)
+  end
+
   def normalize(*args)
     Encoding::Character::UTF8.normalize(self, *args)
   end
 
+  def normalize!(*args)
+    Encoding::Character::UTF8.normalize!(self, *args)
+  end
+
+  def normalized?(*args)
+    Encoding::Character::UTF8.normalized?(self, *args)
+  end
+
   def rindex(*args)
     Encoding::Character::UTF8.rindex(self, *args)
   end
@@ -170,15 +190,29 @@ module Encoding::Character::UTF8::Methods
   def_thunk_replacing_variant :upcase
 
   def capitalize
-    self[0].upcase + self[1..-1].downcase
+    Encoding::Character::UTF8.capitalize(self)
   end
   def_thunk_replacing_variant :capitalize
 
+  def titlecase
+    Encoding::Character::UTF8.titlecase(self)
+  end
+  def_thunk_replacing_variant :titlecase
+
   def foldcase
     Encoding::Character::UTF8.foldcase(self)
   end
   def_thunk_replacing_variant :foldcase
 
+  def nfkc_casefold
+    Encoding::Character::UTF8.nfkc_casefold(self)
+  end
+  def_thunk_replacing_variant :nfkc_casefold
+
+  def fold_hash(*args)
+    Encoding::Character::UTF8.fold_hash(self, *args)
+  end
+
 private
 
   Inspect = String.instance_method(:inspect)
@@ -0,0 +1,41 @@
+# contents: Specification of String#casecmp and String#casecmp?.
+#
+# Copyright © 2006 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "The string “Straße”" do
+  setup do
+    @string = u"Straße"
+  end
+
+  specify "should be equal to “STRASSE” when sent #casecmp" do
+    @string.casecmp(u"STRASSE").should_equal 0
+  end
+
+  specify "should be equal to “STRASSE” when sent #casecmp?" do
+    @string.casecmp?(u"STRASSE").should_equal true
+  end
+
+  specify "should sort before “STRASSEN” when sent #casecmp" do
+    @string.casecmp(u"STRASSEN").should_equal(-1)
+  end
+
+  specify "should sort after “STRASS” when sent #casecmp" do
+    @string.casecmp(u"STRASS").should_equal 1
+  end
+
+  specify "should not be equal to “STRASSEN” when sent #casecmp?" do
+    @string.casecmp?(u"STRASSEN").should_equal false
+  end
+end
+
+context "The string “ΚΑΛΗΜΈΡΑ”" do
+  setup do
+    @string = u"ΚΑΛΗΜΈΡΑ"
+  end
+
+  specify "should be equal to “καλημέρα” when sent #casecmp?" do
+    @string.casecmp?(u"καλημέρα").should_equal true
+  end
+end
@@ -0,0 +1,69 @@
+# contents: Specification of Encoding::Character::UTF8::CharSet.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "A CharSet of everything but letters and digits" do
+  setup do
+    @set = Encoding::Character::UTF8::CharSet.new("^a-zA-Z0-9")
+  end
+
+  specify "should be frozen" do
+    @set.frozen?.should_equal true
+  end
+
+  specify "should include punctuation and non-ASCII letters" do
+    @set.include?(u"-").should_equal true
+    @set.include?(u"ä").should_equal true
+    @set.include?(u"a").should_equal false
+  end
+
+  specify "should be usable in place of its specification" do
+    u"a-b ä 1".count(@set).should_equal 4
+    u"a-b ä 1".delete(@set).should_equal "ab1"
+    Encoding::Character::UTF8.squeeze(u"a--b", @set).should_equal "a-b"
+    u"a-b ä".tr(@set, "_").should_equal "a_b__"
+  end
+
+  specify "should be combined with other specifications" do
+    u"a-b ä 1".count(@set, "^ ").should_equal 2
+  end
+end
+
+context "A CharSet of several specifications" do
+  setup do
+    @set = Encoding::Character::UTF8::CharSet.new("a-m", "^e")
+  end
+
+  specify "should include the characters included by all of them" do
+    u"abcdefz".count(@set).should_equal 5
+  end
+
+  specify "should not be usable with UTF8.tr" do
+    proc{ u"abc".tr(@set, "x") }.should_raise ArgumentError
+  end
+end
+
+context "A CharSet of a range" do
+  setup do
+    @set = Encoding::Character::UTF8::CharSet.new("a-c")
+  end
+
+  specify "should include the bounds of the range but not its “-”" do
+    @set.include?(u"a").should_equal true
+    @set.include?(u"c").should_equal true
+    @set.include?(u"-").should_equal false
+  end
+end
+
+context "A CharSet of a specification too long to be cached" do
+  setup do
+    @set = Encoding::Character::UTF8::CharSet.new("a-cä" * 40)
+  end
+
+  specify "should include the same characters as a short one" do
+    u"a-b ä z".count(@set).should_equal 3
+    u"a-b ä z".count("a-cä" * 40).should_equal 3
+  end
+end
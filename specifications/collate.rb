@@ -0,0 +1,113 @@
+# contents: Specification of String#<=>.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "The string “résumé”" do
+  setup do
+    @string = u"résumé"
+  end
+
+  specify "should sort after “resume” when sent #<=>" do
+    (@string <=> u"resume").should_equal 1
+  end
+
+  specify "should sort after “Resume”, as accents matter more than case, when sent #<=>" do
+    (@string <=> u"Resume").should_equal 1
+  end
+
+  specify "should sort before “resumes” when sent #<=>" do
+    (@string <=> u"resumes").should_equal(-1)
+  end
+
+  specify "should be equal to itself in NFD when sent #<=>" do
+    (@string <=> u"re\314\201sume\314\201").should_equal 0
+  end
+end
+
+context "The string “co-op”" do
+  setup do
+    @string = u"co-op"
+  end
+
+  specify "should sort before “coop”, as punctuation only breaks ties, when sent #<=>" do
+    (@string <=> u"coop").should_equal(-1)
+  end
+
+  specify "should sort before “cop” when sent #<=>" do
+    (@string <=> u"cop").should_equal(-1)
+  end
+end
+
+context "The Tangut ideograph U+17000" do
+  setup do
+    @string = u"\360\227\200\200"
+  end
+
+  specify "should sort before U+18D00 of the Tangut Supplement when sent #<=>" do
+    (@string <=> u"\360\230\264\200").should_equal(-1)
+  end
+
+  specify "should sort before the unassigned U+187F8 when sent #<=>" do
+    (@string <=> u"\360\230\237\270").should_equal(-1)
+  end
+end
+
+context "The collation keys of “résumé”, “resume”, and “Resume”" do
+  setup do
+    @keys = [u"résumé", u"resume", u"Resume"].map{ |s| s.collate_key }
+  end
+
+  specify "should compare as the strings do when sent #<=>" do
+    (@keys[0] <=> @keys[1]).should_equal 1
+    (@keys[0] <=> @keys[2]).should_equal 1
+    (@keys[1] <=> @keys[2]).should_equal(-1)
+  end
+
+  specify "should be equal for equivalent strings" do
+    u"re\314\201sume\314\201".collate_key.should_equal @keys[0]
+  end
+end
+
+context "The collation prefix bounds of “res”" do
+  setup do
+    @lower, @upper = Encoding::Character::UTF8.collate_prefix_bounds(u"res")
+  end
+
+  specify "should include the collation keys of strings beginning with “res”" do
+    [u"res", u"resume", u"Résumé"].each do |s|
+      (s.collate_key >= @lower).should_equal true
+      (s.collate_key < @upper).should_equal true
+    end
+  end
+
+  specify "should not include the collation keys of other strings" do
+    (u"rer".collate_key < @lower).should_equal true
+    (u"ret".collate_key >= @upper).should_equal true
+  end
+end
+
+context "The collation prefix bounds of “”" do
+  specify "should have no upper bound" do
+    Encoding::Character::UTF8.collate_prefix_bounds(u"").should_equal ["", nil]
+  end
+end
+
+context "The collation key prefix of “résumé”" do
+  setup do
+    @key = u"résumé".collate_key
+  end
+
+  specify "should be the beginning of its collation key" do
+    Encoding::Character::UTF8.collate_key_prefix(u"résumé", 8).should_equal @key[0, 8]
+  end
+
+  specify "should be padded with NUL bytes if the collation key is shorter" do
+    Encoding::Character::UTF8.collate_key_prefix(u"résumé", @key.length + 2).should_equal @key + "\0\0"
+  end
+
+  specify "should be packed with the prefixes of other strings by UTF8.collate_key_prefixes" do
+    Encoding::Character::UTF8.collate_key_prefixes([u"résumé", u"resume"], 4).should_equal @key[0, 4] + u"resume".collate_key[0, 4]
+  end
+end
@@ -0,0 +1,57 @@
+# contents: Specification of Encoding::Character::UTF8::Collator.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "A Swedish collator" do
+  setup do
+    @collator = Encoding::Character::UTF8::Collator.new(:locale => 'sv')
+  end
+
+  specify "should sort “å”, “ä”, and “ö” after “z”" do
+    @collator.sort(["ö", "ä", "z", "å"]).should_equal ["z", "å", "ä", "ö"]
+  end
+
+  specify "should treat “å” in NFD as “å”" do
+    @collator.compare("a\314\212", "å").should_equal 0
+  end
+end
+
+context "A secondary-strength collator" do
+  setup do
+    @collator = Encoding::Character::UTF8::Collator.new(:strength => :secondary)
+  end
+
+  specify "should ignore case" do
+    @collator.compare("Resume", "resume").should_equal 0
+  end
+
+  specify "should not ignore accents" do
+    @collator.compare("résumé", "resume").should_equal 1
+  end
+end
+
+context "A numeric collator" do
+  setup do
+    @collator = Encoding::Character::UTF8::Collator.new(:numeric => true)
+  end
+
+  specify "should compare sequences of digits by their value" do
+    @collator.compare("file2", "file10").should_equal(-1)
+  end
+
+  specify "should give keys that compare as the strings do" do
+    (@collator.key("file2") <=> @collator.key("file10")).should_equal(-1)
+  end
+end
+
+context "An upper-first collator" do
+  setup do
+    @collator = Encoding::Character::UTF8::Collator.new(:case_first => :upper)
+  end
+
+  specify "should sort uppercase letters before lowercase ones" do
+    @collator.compare("Resume", "resume").should_equal(-1)
+  end
+end
@@ -27,3 +27,39 @@ context "A string containing one ‘l’" do
     @string.count("helo", "wrld").should_be 1
   end
 end
+
+context "A string containing “a”, “b”, and “ä”" do
+  setup do
+    @string = u"abä"
+  end
+
+  specify "should count only “a” given the range “a-a”" do
+    @string.count("a-a").should_be 1
+  end
+
+  specify "should count only “ä” given everything but “a-z”" do
+    @string.count("^a-z").should_be 1
+  end
+
+  specify "should count “b” and “ä” given “b-ö” and everything but “a”" do
+    @string.count("b-ö", "^a").should_be 2
+  end
+end
+
+context "A string containing “a”, “-”, and “c”" do
+  setup do
+    @string = u"a-c"
+  end
+
+  specify "should not count the “-” of a range" do
+    @string.count("a-c").should_be 2
+  end
+
+  specify "should count a “-” at the end of a specification" do
+    @string.count("a-").should_be 2
+  end
+
+  specify "should skip a range that is out of order, including its bounds" do
+    @string.count("c-a").should_be 0
+  end
+end
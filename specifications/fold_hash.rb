@@ -0,0 +1,47 @@
+# contents: Specification of String#fold_hash.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "The string “Straße”" do
+  setup do
+    @string = u"Straße"
+  end
+
+  specify "should hash like “STRASSE” when sent #fold_hash" do
+    @string.fold_hash.should_equal u"STRASSE".fold_hash
+  end
+
+  specify "should hash like “STRASSE” when sent #fold_hash(:casefold)" do
+    @string.fold_hash(:casefold).should_equal u"STRASSE".fold_hash(:casefold)
+  end
+
+  specify "should not hash like “Strasse” when sent #fold_hash(:nfc)" do
+    @string.fold_hash(:nfc).should_not_equal u"Strasse".fold_hash(:nfc)
+  end
+end
+
+context "The string “é” in NFC" do
+  setup do
+    @string = u"\303\251"
+  end
+
+  specify "should hash like “e\314\201” when sent #fold_hash(:nfc)" do
+    @string.fold_hash(:nfc).should_equal u"e\314\201".fold_hash(:nfc)
+  end
+
+  specify "should hash like “E\314\201” when sent #fold_hash(:nfkc_casefold)" do
+    @string.fold_hash(:nfkc_casefold).should_equal u"E\314\201".fold_hash(:nfkc_casefold)
+  end
+end
+
+context "The string “ﬁ”" do
+  setup do
+    @string = u"ﬁ"
+  end
+
+  specify "should hash like “FI” when sent #fold_hash(:nfkc_casefold)" do
+    @string.fold_hash(:nfkc_casefold).should_equal u"FI".fold_hash(:nfkc_casefold)
+  end
+end
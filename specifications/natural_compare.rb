@@ -0,0 +1,27 @@
+# contents: Specification of String#natural_compare.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "The string “file2”" do
+  setup do
+    @string = u"file2"
+  end
+
+  specify "should sort before “file10” when sent #natural_compare" do
+    @string.natural_compare(u"file10").should_equal(-1)
+  end
+
+  specify "should sort after “File10”, as case matters, when sent #natural_compare" do
+    @string.natural_compare(u"File10").should_equal 1
+  end
+
+  specify "should sort before “File10” when sent #natural_compare with case folding" do
+    @string.natural_compare(u"File10", true).should_equal(-1)
+  end
+
+  specify "should sort before “file١٠”, as non-ASCII digits are numbers, when sent #natural_compare" do
+    @string.natural_compare(u"file\331\241\331\240").should_equal(-1)
+  end
+end
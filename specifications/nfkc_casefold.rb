@@ -0,0 +1,53 @@
+# contents: Specification of String#nfkc_casefold.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "The string “Straße”" do
+  setup do
+    @string = u"Straße"
+  end
+
+  specify "should equal “strasse” when sent #nfkc_casefold" do
+    @string.nfkc_casefold.should_equal u"strasse"
+  end
+end
+
+context "The string “ﬁ\302\255X”" do
+  setup do
+    @string = u"ﬁ\302\255X"
+  end
+
+  specify "should lose its soft hyphen and be folded when sent #nfkc_casefold" do
+    @string.nfkc_casefold.should_equal u"fix"
+  end
+end
+
+context "The string “ᾼ” in NFD with a combining acute accent" do
+  setup do
+    @string = u"\316\221\315\205\314\201"
+  end
+
+  specify "should map the ypogegrammeni after ordering the marks when sent #nfkc_casefold" do
+    @string.nfkc_casefold.should_equal u"\316\254\316\271"
+  end
+
+  specify "should equal #normalize(:nfkc_casefold) when sent #nfkc_casefold" do
+    @string.nfkc_casefold.should_equal @string.normalize(:nfkc_casefold)
+  end
+end
+
+context "The string “already folded”" do
+  setup do
+    @string = u"already folded"
+  end
+
+  specify "should be normalized?(:nfkc_casefold)" do
+    @string.normalized?(:nfkc_casefold).should_equal true
+  end
+
+  specify "should return an equal copy when sent #nfkc_casefold" do
+    @string.nfkc_casefold.should_equal @string
+  end
+end
@@ -0,0 +1,41 @@
+# contents: Specification of String#normalize.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "A string with a long run of combining marks out of canonical order" do
+  setup do
+    @string = u"a" + u"\314\226\314\201" * 50
+  end
+
+  specify "should have the marks sorted by combining class, keeping equal ones in order, when sent #normalize(:nfd)" do
+    @string.normalize(:nfd).should_equal u"a" + u"\314\226" * 50 + u"\314\201" * 50
+  end
+end
+
+context "The string “déja” in NFD" do
+  setup do
+    @string = u"de\314\201ja"
+  end
+
+  specify "should be composed in place when sent #normalize!(:nfc)" do
+    @string.normalize!(:nfc).should_equal u"d\303\251ja"
+    @string.should_equal u"d\303\251ja"
+  end
+
+  specify "should return nil when sent #normalize!(:nfd)" do
+    @string.normalize!(:nfd).should_equal nil
+    @string.should_equal u"de\314\201ja"
+  end
+end
+
+context "The string “a” followed by U+0344 COMBINING GREEK DIALYTIKA TONOS" do
+  setup do
+    @string = u"a\315\204"
+  end
+
+  specify "should grow when sent #normalize!(:nfc), as “a” composes with the diaeresis that the mark decomposes into" do
+    @string.normalize!(:nfc).should_equal u"\303\244\314\201"
+  end
+end
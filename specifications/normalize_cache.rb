@@ -0,0 +1,32 @@
+# contents: Specification of Encoding::Character::UTF8::NormalizeCache.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "A NormalizeCache with room for two strings" do
+  setup do
+    @cache = Encoding::Character::UTF8::NormalizeCache.new(2)
+  end
+
+  specify "should return the same frozen string for repeated lookups" do
+    first = @cache.normalize("e\314\201", :nfc)
+    first.should_equal "\303\251"
+    first.frozen?.should_equal true
+    @cache.normalize("e\314\201", :nfc).equal?(first).should_equal true
+    @cache.hits.should_equal 1
+    @cache.misses.should_equal 1
+  end
+
+  specify "should forget the least recently used string when full" do
+    @cache.normalize("a")
+    @cache.normalize("b")
+    @cache.normalize("a")
+    @cache.normalize("c")
+    @cache.size.should_equal 2
+    @cache.normalize("b")
+    @cache.misses.should_equal 4
+    @cache.normalize("a")
+    @cache.hits.should_equal 1
+  end
+end
@@ -0,0 +1,47 @@
+# contents: Specification of String#normalized?.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "The string “é” in NFC" do
+  setup do
+    @string = u"\303\251"
+  end
+
+  specify "should be normalized when sent #normalized?(:nfc)" do
+    @string.normalized?(:nfc).should_equal true
+  end
+
+  specify "should not be normalized when sent #normalized?(:nfd)" do
+    @string.normalized?(:nfd).should_equal false
+  end
+end
+
+context "The string “é” in NFD" do
+  setup do
+    @string = u"e\314\201"
+  end
+
+  specify "should be normalized when sent #normalized?" do
+    @string.normalized?.should_equal true
+  end
+
+  specify "should not be normalized when sent #normalized?(:nfc)" do
+    @string.normalized?(:nfc).should_equal false
+  end
+end
+
+context "The string “ﬁ”" do
+  setup do
+    @string = u"ﬁ"
+  end
+
+  specify "should be normalized when sent #normalized?(:nfc)" do
+    @string.normalized?(:nfc).should_equal true
+  end
+
+  specify "should not be normalized when sent #normalized?(:nfkc)" do
+    @string.normalized?(:nfkc).should_equal false
+  end
+end
@@ -0,0 +1,33 @@
+# contents: Specification of Encoding::Character::UTF8::Normalizer.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "An NFC normalizer" do
+  setup do
+    @normalizer = Encoding::Character::UTF8::Normalizer.new(:nfc)
+  end
+
+  specify "should compose a combining character fed after its base" do
+    (@normalizer.feed("de") + @normalizer.feed("\314\201ja") +
+     @normalizer.finish).should_equal "d\303\251ja"
+  end
+
+  specify "should accept a character split across chunks" do
+    (@normalizer.feed("d\303") + @normalizer.feed("\251") +
+     @normalizer.finish).should_equal "d\303\251"
+  end
+
+  specify "should pass NULs through as characters of their own" do
+    (@normalizer.feed("ab\000cd") + @normalizer.feed("ef") +
+     @normalizer.finish).should_equal "ab\000cdef"
+    (@normalizer.feed("e\000") + @normalizer.feed("\314\201") +
+     @normalizer.finish).should_equal "e\000\314\201"
+  end
+
+  specify "should raise ArgumentError if the input ends in the middle of a character" do
+    @normalizer.feed("d\303")
+    proc{ @normalizer.finish }.should_raise ArgumentError
+  end
+end
@@ -0,0 +1,24 @@
+# contents: Specification of UTF8.sort.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "An array of “résumé”, “Resume”, and “resume”" do
+  setup do
+    @array = [u"résumé", u"Resume", u"resume"]
+  end
+
+  specify "should be ordered by collation when sent to UTF8.sort" do
+    Encoding::Character::UTF8.sort(@array).should_equal [u"resume", u"Resume", u"résumé"]
+  end
+
+  specify "should keep the order of equal elements when sent to UTF8.sort" do
+    Encoding::Character::UTF8.sort([u"re\314\201sume\314\201", u"résumé"]).should_equal ["re\314\201sume\314\201", "résumé"]
+  end
+
+  specify "should be sorted in place when sent to UTF8.sort_by_collation!" do
+    Encoding::Character::UTF8.sort_by_collation!(@array)
+    @array.should_equal [u"resume", u"Resume", u"résumé"]
+  end
+end
@@ -0,0 +1,43 @@
+# contents: Specification of String#capitalize and String#titlecase.
+#
+# Copyright © 2007 Nikolai Weibull <now@bitwi.se>
+
+require 'encoding/character/utf-8'
+
+context "An empty string" do
+  setup do
+    @string = u""
+  end
+
+  specify "should remain empty when sent #capitalize" do
+    @string.capitalize.should_equal ""
+  end
+
+  specify "should remain empty when sent #titlecase" do
+    @string.titlecase.should_equal ""
+  end
+end
+
+context "The string “éCOLE normale, don’t”" do
+  setup do
+    @string = u"éCOLE normale, don’t"
+  end
+
+  specify "should return “École normale, don’t” when sent #capitalize" do
+    @string.capitalize.should_equal "École normale, don’t"
+  end
+
+  specify "should return “École Normale, Don’t” when sent #titlecase" do
+    @string.titlecase.should_equal "École Normale, Don’t"
+  end
+end
+
+context "The string “ǆemal ﬁne”" do
+  setup do
+    @string = u"ǆemal ﬁne"
+  end
+
+  specify "should titlecase digraphs and ligatures when sent #titlecase" do
+    @string.titlecase.should_equal "ǅemal Fine"
+  end
+end